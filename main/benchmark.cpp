@@ -0,0 +1,667 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "benchmark.hpp"
+
+#include "gpio.hpp"
+#include "portdispatcher.hpp"
+#include "portwriter.hpp"
+#include "singleton.hpp"
+#include "wrappers/executor.hpp"
+#include "wrappers/periodic.hpp"
+#include "wrappers/poolqueue.hpp"
+#include "wrappers/queue.hpp"
+#include "wrappers/semphr.hpp"
+#include "wrappers/sharablequeue.hpp"
+#include "wrappers/task.hpp"
+#include "wrappers/timerwheel.hpp"
+
+#include "driver/gpio.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <queue>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace benchmark
+{
+
+    static constexpr const char *const TAG{"Benchmark"};
+
+    template <class Storage>
+    struct Subject : public Singleton<Subject<Storage>, Storage>
+    {
+        std::uint32_t value{0};
+    };
+
+    template <class Storage>
+    [[nodiscard]] static constexpr const char *storage_name()
+    {
+        return std::is_same_v<Storage, singleton::Static> ? "static" : "heap";
+    }
+
+    struct SingletonArgs
+    {
+        std::uint32_t iterations;
+        semphr::Semaphore &done;
+    };
+
+    template <class Storage>
+    [[noreturn]] static void singleton_task(void *arg)
+    {
+        auto &args = *static_cast<SingletonArgs *>(arg);
+
+        const auto start = esp_timer_get_time();
+        for (std::uint32_t i = 0; i < args.iterations; ++i)
+        {
+            auto shared = Subject<Storage>::get_shared();
+            ++shared->value; // NOTE: Racy on purpose; only here so the call isn't optimised away
+        }
+        const auto elapsed = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "%s get_shared on core %d: %lu calls, %.0f ns/call", storage_name<Storage>(), xPortGetCoreID(), args.iterations, 1000.0 * elapsed / args.iterations);
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Storage>
+    static void singleton_contention(std::size_t tasks, std::uint32_t iterations)
+    {
+        auto done = semphr::make_counting_semaphore(tasks);
+        SingletonArgs args{iterations, done};
+
+        auto keepalive = Subject<Storage>::get_shared(); // NOTE: Measures the common case, where the instance already exists
+
+        std::vector<task::Task> workers;
+        for (std::size_t i = 0; i < tasks; ++i)
+            workers.push_back(task::make_task(singleton_task<Storage>, "bench_singleton", 3072, &args, 5));
+
+        for (std::size_t i = 0; i < tasks; ++i)
+            (void)semphr::take(done);
+    }
+
+    // NOTE: Heap consumed by a live instance and the cost of copying a handle to it
+    template <class Storage>
+    static void singleton_footprint(std::uint32_t iterations)
+    {
+        const auto before = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        auto shared = Subject<Storage>::get_shared();
+        const auto used = before - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+
+        const auto start = esp_timer_get_time();
+        for (std::uint32_t i = 0; i < iterations; ++i)
+        {
+            auto copy = shared;
+            ++copy->value;
+        }
+        const auto elapsed = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "%s singleton: %zu heap bytes, %.0f ns/copy", storage_name<Storage>(), used, 1000.0 * elapsed / iterations);
+    }
+
+    void singleton_contention(std::size_t tasks, std::uint32_t iterations)
+    {
+        singleton_footprint<singleton::Heap>(iterations);
+        singleton_footprint<singleton::Static>(iterations);
+
+        singleton_contention<singleton::Heap>(tasks, iterations);
+        singleton_contention<singleton::Static>(tasks, iterations);
+
+        ESP_LOGI(TAG, "Singleton contention: %zu tasks done", tasks);
+    }
+
+    static constexpr std::size_t chunk_size{512};
+
+    [[nodiscard]] static std::uint32_t checksum(const std::uint8_t *data, std::size_t size, std::size_t rounds)
+    {
+        std::uint32_t a{1};
+        std::uint32_t b{0};
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                a = (a + data[i]) % 65521;
+                b = (b + a) % 65521;
+            }
+        }
+        return (b << 16) | a;
+    }
+
+    void executor_scaling(std::size_t chunks, std::size_t rounds)
+    {
+        static std::array<std::uint8_t, 16 * chunk_size> data{};
+        for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<std::uint8_t>(i * 31);
+
+        std::vector<std::uint32_t> results(chunks);
+
+        auto start = esp_timer_get_time();
+        for (std::size_t i = 0; i < chunks; ++i)
+            results[i] = checksum(&data[(i * chunk_size) % data.size()], chunk_size, rounds);
+        const auto inline_us = esp_timer_get_time() - start;
+
+        task::Executor executor{};
+        auto done = semphr::make_counting_semaphore(chunks);
+
+        start = esp_timer_get_time();
+        for (std::size_t i = 0; i < chunks; ++i)
+        {
+            auto job = [&, i]
+            {
+                results[i] = checksum(&data[(i * chunk_size) % data.size()], chunk_size, rounds);
+                semphr::give(done);
+            };
+            while (not executor.submit(job))
+                task::delay(std::chrono::milliseconds{1});
+        }
+        for (std::size_t i = 0; i < chunks; ++i)
+            (void)semphr::take(done);
+        const auto pooled_us = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "Executor: %zu checksum jobs, inline %lld us, %zu workers %lld us", chunks, inline_us, executor.size(), pooled_us);
+    }
+
+    struct PeriodicArgs
+    {
+        const char *name;
+        std::chrono::milliseconds period;
+        std::uint32_t releases;
+        std::uint32_t overrun_every; // NOTE: 0 never overruns on purpose
+        semphr::Semaphore &done;
+    };
+
+    [[noreturn]] static void periodic_task(void *arg)
+    {
+        auto &args = *static_cast<PeriodicArgs *>(arg);
+        static std::array<std::uint8_t, chunk_size> data{};
+
+        task::Periodic periodic{args.period};
+        std::uint32_t sink{0};
+
+        for (std::uint32_t i = 1; i <= args.releases; ++i)
+        {
+            periodic.wait();
+
+            sink += checksum(data.data(), data.size(), 1); // NOTE: Stands in for reading a sensor
+            if (args.overrun_every and 0 == i % args.overrun_every)
+                esp_rom_delay_us(2500 * args.period.count()); // NOTE: Busy for two and a half periods
+        }
+
+        ESP_LOGD(TAG, "%s checksum %lu", args.name, sink);
+        periodic.log_stats(args.name);
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    void periodic_jitter(std::uint32_t releases)
+    {
+        auto done = semphr::make_counting_semaphore(2);
+        PeriodicArgs fast{"periodic_fast", std::chrono::milliseconds{10}, releases, 100, done};
+        PeriodicArgs slow{"periodic_slow", std::chrono::milliseconds{30}, releases / 3, 0, done};
+
+        auto fast_task = task::make_task(periodic_task, "bench_fast", 3072, &fast, 6);
+        auto slow_task = task::make_task(periodic_task, "bench_slow", 3072, &slow, 6);
+
+        for (std::uint32_t i = 0; i < releases / 100; ++i)
+            executor_scaling(); // NOTE: Load on both cores while the loops run
+
+        for (std::size_t i = 0; i < 2; ++i)
+            (void)semphr::take(done);
+    }
+
+    using BatchQueue = queue::SharableQueue<std::uint32_t>;
+    using BatchHandle = queue::QueueHandle<std::uint32_t>;
+
+    static constexpr std::size_t batch_size{16};
+
+    template <class Queue>
+    struct BatchArgs
+    {
+        Queue &queue;
+        std::uint32_t items;
+        std::uint32_t burst;
+        bool batched;
+        semphr::Semaphore &done;
+        std::uint32_t wakeups{0};
+    };
+
+    static void batch_push(BatchQueue &queue, std::uint32_t value) { (void)queue.push(value); }
+    static void batch_push(BatchHandle &queue, std::uint32_t value) { (void)queue.send(value); }
+
+    [[nodiscard]] static std::size_t batch_pop(BatchQueue &queue, std::span<std::uint32_t> items, bool batched)
+    {
+        if (batched)
+            return queue.pop_wait_batch(items);
+        return queue.pop_wait().success ? 1 : 0;
+    }
+
+    [[nodiscard]] static std::size_t batch_pop(BatchHandle &queue, std::span<std::uint32_t> items, bool batched)
+    {
+        if (batched)
+            return queue.receive_many(items);
+        return queue.receive().success ? 1 : 0;
+    }
+
+    template <class Queue>
+    [[noreturn]] static void batch_producer(void *arg)
+    {
+        auto &args = *static_cast<BatchArgs<Queue> *>(arg);
+
+        for (std::uint32_t i = 0; i < args.items;)
+        {
+            for (std::uint32_t j = 0; j < args.burst and i < args.items; ++j, ++i)
+                batch_push(args.queue, i);
+            esp_rom_delay_us(100); // NOTE: Quiet gap between bursts, like an edge storm settling
+        }
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Queue>
+    [[noreturn]] static void batch_consumer(void *arg)
+    {
+        auto &args = *static_cast<BatchArgs<Queue> *>(arg);
+        std::array<std::uint32_t, batch_size> items{};
+
+        for (std::uint32_t received = 0; received < args.items;)
+        {
+            if (args.queue.empty())
+                ++args.wakeups; // NOTE: This call has to block, so the task is woken for what it returns
+            received += batch_pop(args.queue, items, args.batched);
+        }
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Queue>
+    static void queue_batching(const char *name, Queue &queue, std::uint32_t items, std::uint32_t burst, bool batched)
+    {
+        auto done = semphr::make_counting_semaphore(2);
+        BatchArgs<Queue> args{queue, items, burst, batched, done};
+
+        const auto start = esp_timer_get_time();
+        {
+            auto consumer = task::make_task_pinned(batch_consumer<Queue>, "bench_consumer", 3072, &args, 6, 0);
+            auto producer = task::make_task_pinned(batch_producer<Queue>, "bench_producer", 3072, &args, 5, 1);
+
+            for (std::size_t i = 0; i < 2; ++i)
+                (void)semphr::take(done);
+        }
+        const auto elapsed = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "%s %s: %lu items in %lld us, %.0f items/s, %.3f wakeups/item", name, batched ? "batched" : "single", items, elapsed,
+                 1e6 * items / elapsed, static_cast<double>(args.wakeups) / items);
+    }
+
+    void queue_batching(std::uint32_t items, std::uint32_t burst)
+    {
+        BatchQueue sharable{};
+        auto handle = queue::make_queue<std::uint32_t>(4 * batch_size);
+
+        for (const auto batched : {false, true})
+        {
+            queue_batching("SharableQueue", sharable, items, burst, batched);
+            queue_batching("QueueHandle", *handle, items, burst, batched);
+        }
+    }
+
+    template <class Queue>
+    struct WakeArgs
+    {
+        Queue &queue;
+        std::uint32_t samples;
+        semphr::Semaphore &done;
+        std::int64_t min{std::numeric_limits<std::int64_t>::max()};
+        std::int64_t max{0};
+        std::int64_t sum{0};
+    };
+
+    template <class Queue>
+    [[noreturn]] static void wake_producer(void *arg)
+    {
+        auto &args = *static_cast<WakeArgs<Queue> *>(arg);
+
+        for (std::uint32_t i = 0; i < args.samples; ++i)
+        {
+            esp_rom_delay_us(200); // NOTE: Long enough for the consumer to be blocked again before the next push
+            (void)args.queue.push(esp_timer_get_time());
+        }
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Queue>
+    [[noreturn]] static void wake_consumer(void *arg)
+    {
+        auto &args = *static_cast<WakeArgs<Queue> *>(arg);
+
+        for (std::uint32_t i = 0; i < args.samples; ++i)
+        {
+            const auto ret = args.queue.pop_wait();
+            const auto latency = esp_timer_get_time() - ret.item;
+
+            args.min = std::min(args.min, latency);
+            args.max = std::max(args.max, latency);
+            args.sum += latency;
+        }
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Signal>
+    static void wake_latency(const char *name, std::uint32_t samples)
+    {
+        using Queue = queue::SharableQueue<std::int64_t, std::queue<std::int64_t>, Signal>;
+
+        Queue queue{}; // NOTE: Fresh per run, a notification belongs to the first task that waits on it
+        auto done = semphr::make_counting_semaphore(2);
+        WakeArgs<Queue> args{queue, samples, done};
+
+        {
+            auto consumer = task::make_task_pinned(wake_consumer<Queue>, "bench_consumer", 3072, &args, 6, 0);
+            auto producer = task::make_task_pinned(wake_producer<Queue>, "bench_producer", 3072, &args, 5, 1);
+
+            for (std::size_t i = 0; i < 2; ++i)
+                (void)semphr::take(done);
+        }
+
+        ESP_LOGI(TAG, "%s: push to wake min %lld us, mean %.1f us, max %lld us over %lu samples", name, args.min,
+                 static_cast<double>(args.sum) / samples, args.max, samples);
+    }
+
+    void wake_latency(std::uint32_t samples)
+    {
+        wake_latency<queue::SemaphoreSignal>("SemaphoreSignal", samples);
+        wake_latency<queue::NotificationSignal>("NotificationSignal", samples);
+    }
+
+    static constexpr std::size_t payload_depth{4};
+
+    template <class Queue>
+    struct PayloadArgs
+    {
+        Queue &queue;
+        std::uint32_t items;
+        semphr::Semaphore &done;
+        std::uint32_t checksum{0};
+    };
+
+    template <std::size_t Size>
+    using Payload = std::array<std::byte, Size>;
+
+    template <std::size_t Size>
+    using CopyQueue = queue::QueueHandle<Payload<Size>>;
+
+    template <std::size_t Size>
+    using ZeroCopyQueue = queue::BufferPool<Size, payload_depth>;
+
+    static void fill(std::span<std::byte> payload, std::uint32_t value)
+    {
+        std::memset(payload.data(), static_cast<int>(value), payload.size()); // NOTE: Same producer work in both variants
+    }
+
+    [[nodiscard]] static std::uint32_t touch(std::span<const std::byte> payload)
+    {
+        return std::to_integer<std::uint32_t>(payload.front()) + std::to_integer<std::uint32_t>(payload.back());
+    }
+
+    template <std::size_t Size>
+    static void payload_send(CopyQueue<Size> &queue, std::uint32_t value)
+    {
+        Payload<Size> payload;
+        fill(payload, value);
+        (void)queue.send(payload);
+    }
+
+    template <std::size_t Size>
+    static void payload_send(ZeroCopyQueue<Size> &queue, std::uint32_t value)
+    {
+        auto buffer = queue.acquire();
+        fill(*buffer, value);
+        (void)queue.send(std::move(buffer));
+    }
+
+    template <std::size_t Size>
+    [[nodiscard]] static std::uint32_t payload_receive(CopyQueue<Size> &queue)
+    {
+        const auto ret = queue.receive();
+        return touch(ret.item);
+    }
+
+    template <std::size_t Size>
+    [[nodiscard]] static std::uint32_t payload_receive(ZeroCopyQueue<Size> &queue)
+    {
+        const auto buffer = queue.receive();
+        return touch(*buffer);
+    }
+
+    template <class Queue>
+    [[noreturn]] static void payload_producer(void *arg)
+    {
+        auto &args = *static_cast<PayloadArgs<Queue> *>(arg);
+
+        for (std::uint32_t i = 0; i < args.items; ++i)
+            payload_send(args.queue, i);
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <class Queue>
+    [[noreturn]] static void payload_consumer(void *arg)
+    {
+        auto &args = *static_cast<PayloadArgs<Queue> *>(arg);
+
+        for (std::uint32_t i = 0; i < args.items; ++i)
+            args.checksum += payload_receive(args.queue);
+
+        semphr::give(args.done);
+        task::delay_forever();
+    }
+
+    template <std::size_t Size, class Queue>
+    static void payload_throughput(const char *name, Queue &queue, std::uint32_t items)
+    {
+        static constexpr std::uint32_t stack_size{3072 + 4 * Size}; // NOTE: The copying path holds a few payloads on the stack at once
+
+        auto done = semphr::make_counting_semaphore(2);
+        PayloadArgs<Queue> args{queue, items, done};
+
+        const auto start = esp_timer_get_time();
+        {
+            auto consumer = task::make_task_pinned(payload_consumer<Queue>, "bench_consumer", stack_size, &args, 5, 0);
+            auto producer = task::make_task_pinned(payload_producer<Queue>, "bench_producer", stack_size, &args, 5, 1);
+
+            for (std::size_t i = 0; i < 2; ++i)
+                (void)semphr::take(done);
+        }
+        const auto elapsed = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "%s %4u B: %lu items in %lld us, %.0f items/s, %.2f MB/s (checksum %lu)", name, Size, items, elapsed,
+                 1e6 * items / elapsed, static_cast<double>(items) * Size / elapsed, args.checksum);
+    }
+
+    template <std::size_t Size>
+    static void payload_throughput(std::uint32_t items)
+    {
+        auto copying = queue::make_queue<Payload<Size>>(payload_depth);
+        auto pooled = std::make_unique<ZeroCopyQueue<Size>>(); // NOTE: The pool's slots are too big for this task's stack
+
+        payload_throughput<Size>("QueueHandle", *copying, items);
+        payload_throughput<Size>("PoolQueue  ", *pooled, items);
+    }
+
+    void payload_throughput(std::uint32_t items)
+    {
+        payload_throughput<64>(items);
+        payload_throughput<1024>(items);
+        payload_throughput<4096>(items);
+    }
+
+    static constexpr std::array dispatch_pins{GPIO_NUM_16, GPIO_NUM_17, GPIO_NUM_18, GPIO_NUM_19};
+    static constexpr std::uint32_t dispatch_timeout_cycles{1'000'000}; // NOTE: A few ms, in case a pin is wired to something after all
+
+    static constexpr gpio_config_t dispatch_config{.pin_bit_mask = 0,
+                                                   .mode = GPIO_MODE_INPUT_OUTPUT,
+                                                   .pull_up_en = GPIO_PULLUP_DISABLE,
+                                                   .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                                                   .intr_type = GPIO_INTR_ANYEDGE};
+
+    static gpio::IsrQueue *dispatch_queue{nullptr};
+
+    IRAM_ATTR static void dispatch_pin_isr(const gpio::IsrRet &event) { dispatch_queue->push_from_isr(event); }
+
+    template <gpio_num_t PIN>
+    using DispatchPin = gpio::StaticGpio<PIN, dispatch_config, dispatch_pin_isr>;
+
+    [[nodiscard]] static constexpr std::uint64_t dispatch_mask()
+    {
+        std::uint64_t mask{0};
+        for (const auto pin : dispatch_pins)
+            mask |= 1ULL << pin;
+        return mask;
+    }
+
+    // NOTE: The interrupts are allocated on this core, so they preempt the wait loop as soon as the store lands
+    template <class Queue>
+    static void dispatch_cycles(const char *name, Queue &queue, std::size_t events, std::uint32_t rounds)
+    {
+        std::uint64_t cycles{0};
+        std::uint32_t timeouts{0};
+
+        for (std::uint32_t round = 0; round < rounds; ++round)
+        {
+            const auto start = esp_cpu_get_cycle_count();
+            if (round & 1)
+                gpio::PortWriter::write_masks(0, dispatch_mask());
+            else
+                gpio::PortWriter::write_masks(dispatch_mask(), 0);
+
+            while (queue.size() < events and esp_cpu_get_cycle_count() - start < dispatch_timeout_cycles)
+                ;
+            const auto elapsed = esp_cpu_get_cycle_count() - start;
+
+            if (queue.size() < events)
+                ++timeouts;
+            else
+                cycles += elapsed;
+
+            while (queue.pop())
+                ;
+        }
+
+        const auto counted = rounds - timeouts;
+        const auto mean = counted ? static_cast<double>(cycles) / counted : 0.0;
+        ESP_LOGI(TAG, "%s: %.0f cycles from toggling %zu pins to their events queued, %.0f per pin; %lu of %lu rounds timed out", name, mean,
+                 dispatch_pins.size(), mean / dispatch_pins.size(), timeouts, rounds);
+    }
+
+    void dispatch_cycles(std::uint32_t rounds)
+    {
+        {
+            auto config = dispatch_config;
+            config.pin_bit_mask = dispatch_mask();
+
+            auto dispatcher = gpio::make_port_dispatcher(config);
+            if (not dispatcher)
+                return;
+
+            dispatch_cycles("PortDispatcher", *dispatcher->get_queue(), 1, rounds);
+        }
+
+        auto queue = queue::make_ringqueue<gpio::IsrRet, gpio::isr_queue_depth>();
+        dispatch_queue = queue.get();
+        {
+            DispatchPin<dispatch_pins[0]> pin0{};
+            DispatchPin<dispatch_pins[1]> pin1{};
+            DispatchPin<dispatch_pins[2]> pin2{};
+            DispatchPin<dispatch_pins[3]> pin3{};
+
+            dispatch_cycles("Per-pin ISRs  ", *queue, dispatch_pins.size(), rounds);
+        }
+        dispatch_queue = nullptr; // NOTE: The last pin to go uninstalled the ISR service, so the application's own GPIO setup starts from scratch
+    }
+
+    static void noop_callback(timer::Timer &) {}
+
+    // NOTE: Up to a minute at 1 ms ticks, so every level of the wheel is in use
+    [[nodiscard]] static std::uint32_t next_delay(std::uint32_t &seed)
+    {
+        seed = seed * 1664525 + 1013904223;
+        return 1 + (seed >> 8) % 60'000;
+    }
+
+    static void timer_wheel(std::size_t count, std::uint32_t ticks)
+    {
+        std::unique_ptr<timer::Timer[]> timers{new (std::nothrow) timer::Timer[count]};
+        std::unique_ptr<timer::Wheel<>> wheel{new (std::nothrow) timer::Wheel<>{}};
+        if (not timers or not wheel)
+        {
+            ESP_LOGW(TAG, "Timer wheel: no room for %zu timers", count);
+            return;
+        }
+
+        std::uint32_t seed{1};
+
+        auto start = esp_timer_get_time();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            timers[i].callback = noop_callback;
+            wheel->schedule_in(timers[i], next_delay(seed));
+        }
+        const auto schedule_us = esp_timer_get_time() - start;
+
+        start = esp_timer_get_time();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto &timer = timers[(i * 7919) % count];
+            wheel->cancel(timer);
+            wheel->schedule_in(timer, next_delay(seed));
+        }
+        const auto cancel_us = esp_timer_get_time() - start;
+
+        std::size_t expired{0};
+        timer::List due{};
+
+        start = esp_timer_get_time();
+        for (std::uint32_t tick = 1; tick <= ticks; ++tick)
+        {
+            expired += wheel->advance(wheel->now() + 1, due);
+            while (auto timer = due.pop_front())
+            {
+                timer->callback(*timer);
+                wheel->schedule_in(*timer, next_delay(seed)); // NOTE: Keeps the count outstanding
+            }
+        }
+        const auto advance_us = esp_timer_get_time() - start;
+
+        ESP_LOGI(TAG, "Timer wheel, %zu timers: schedule %.0f ns, cancel+reschedule %.0f ns, %lu ticks at %.0f ns/tick with %zu expiries", count, 1000.0 * schedule_us / count,
+                 1000.0 * cancel_us / count, ticks, 1000.0 * advance_us / ticks, expired);
+
+        for (std::size_t i = 0; i < count; ++i)
+            wheel->cancel(timers[i]);
+    }
+
+    void timer_wheel()
+    {
+        for (const std::size_t count : {10, 1'000, 10'000})
+            timer_wheel(count, 5'000);
+    }
+
+} // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace benchmark
+{
+
+    // NOTE: For each singleton storage policy, logs heap use and handle copy cost, then has tasks hammer get_shared on a live instance and
+    // logs the mean cost per call; blocks until they all finish
+    void singleton_contention(std::size_t tasks = 4, std::uint32_t iterations = 100'000);
+
+    // NOTE: Checksums a buffer in chunks inline and then on a task::Executor, logging both times
+    void executor_scaling(std::size_t chunks = 64, std::size_t rounds = 16);
+
+    // NOTE: Runs two task::Periodic loops at different rates alongside the executor benchmark as load, forcing the occasional overrun in
+    // the fast one, and logs each loop's jitter and overrun stats; blocks until both finish
+    void periodic_jitter(std::uint32_t releases = 500);
+
+    // NOTE: A producer on core 1 pushes bursts that a consumer on core 0 drains one item per call and then in batches, through both a
+    // SharableQueue and a QueueHandle; logs items/sec and the consumer's wakeups per item for each
+    void queue_batching(std::uint32_t items = 20'000, std::uint32_t burst = 16);
+
+    // NOTE: A producer on core 1 pushes timestamps one at a time to a consumer blocked on core 0, through a SharableQueue signalled by a
+    // counting semaphore and then by a task notification; logs min/mean/max push-to-wake latency for each
+    void wake_latency(std::uint32_t samples = 2'000);
+
+    // NOTE: Streams 64 B, 1 KiB and 4 KiB payloads from a producer on core 1 to a consumer on core 0, once copied through a QueueHandle and
+    // once filled in place and passed by slot index through a PoolQueue; logs items/sec and MB/s for each
+    void payload_throughput(std::uint32_t items = 2'000);
+
+    // NOTE: Drives GPIO16-19 as input+output, so writing them raises their own interrupts, and counts the CPU cycles from one store toggling
+    // all four until their events are queued: through a PortDispatcher, then through per-pin StaticGpio handlers. The pins must be left
+    // unconnected, and it has to run before anything else installs a GPIO interrupt.
+    void dispatch_cycles(std::uint32_t rounds = 1'000);
+
+    // NOTE: Logs the cost of timer::Wheel schedule, cancel and per-tick advance with 10, 1k and 10k timers outstanding
+    void timer_wheel();
+
+} // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,168 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#include "esp_log.h"
+
+#include "capture.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+namespace gpio
+{
+
+    static constexpr const char *const TAG{"Capture"};
+
+    // NOTE: Little-endian, packed by hand so the layout doesn't depend on the compiler
+    static constexpr std::uint8_t magic[4]{'G', 'C', 'A', 'P'};
+    static constexpr std::uint16_t format_version{1};
+    static constexpr std::size_t header_size{4 + 2 + 2 + 4 + 4 + 8 + 8};
+    static constexpr std::size_t sample_size{4 + 8 + 8}; // NOTE: Time is stored as a 32 bit offset from the first sample
+
+    template <class T>
+    static std::uint8_t *put(std::uint8_t *out, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            *out++ = static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i));
+        return out;
+    }
+
+    void Capture::arm(CaptureTrigger trigger, std::size_t pre, std::size_t post)
+    {
+        assert(pre + 1 + post <= ring.size());
+        assert(0 == (trigger.mask & ~pins));
+
+        stop();
+
+        this->trigger = trigger;
+        this->pre = pre;
+        this->post = post;
+        head = written = pre_count = remaining = trigger_position = 0;
+        triggered = false;
+
+        state.store(State::Armed); // NOTE: Publishes the setup above to the ISR
+
+        ESP_LOGI(TAG, "Armed on 0x%llx, trigger 0x%llx=0x%llx, %zu pre %zu post", pins, trigger.mask, trigger.levels, pre, post);
+    }
+
+    void Capture::stop()
+    {
+        const auto previous = state.exchange(State::Done);
+
+        while (recording.load()) // NOTE: An ISR on the other core may still be writing a sample
+        {
+        }
+
+        if (State::Idle == previous)
+            state.store(State::Idle);
+    }
+
+    std::size_t Capture::size() const
+    {
+        if (State::Done != state.load())
+            return 0;
+
+        return triggered ? pre_count + 1 + (post - remaining) : written;
+    }
+
+    std::size_t Capture::first() const
+    {
+        const auto back = triggered ? pre_count : written;
+        const auto from = triggered ? trigger_position : head;
+        return (from + ring.size() - back) % ring.size();
+    }
+
+    std::uint32_t Capture::trigger_index() const
+    {
+        return triggered and State::Done == state.load() ? static_cast<std::uint32_t>(pre_count) : no_trigger;
+    }
+
+    const CaptureSample &Capture::operator[](std::size_t index) const
+    {
+        assert(index < size());
+        return ring[(first() + index) % ring.size()];
+    }
+
+    std::int64_t Capture::start_us() const
+    {
+        return size() ? (*this)[0].timestamp_us : 0;
+    }
+
+    std::uint8_t *Capture::put_header(std::uint8_t *out) const
+    {
+        std::memcpy(out, magic, sizeof(magic));
+        out = put(out + sizeof(magic), format_version);
+        out = put(out, static_cast<std::uint16_t>(sample_size));
+        out = put(out, static_cast<std::uint32_t>(size()));
+        out = put(out, trigger_index());
+        out = put(out, pins);
+        return put(out, start_us());
+    }
+
+    std::uint8_t *Capture::put_sample(std::uint8_t *out, std::size_t index) const
+    {
+        const auto &sample = (*this)[index];
+        out = put(out, static_cast<std::uint32_t>(sample.timestamp_us - start_us()));
+        out = put(out, sample.changed);
+        return put(out, sample.levels);
+    }
+
+    std::size_t Capture::export_binary(std::span<std::uint8_t> out) const
+    {
+        const auto count = size();
+        const auto needed = header_size + count * sample_size;
+
+        if (out.size() < needed)
+            return needed;
+
+        auto cursor = put_header(out.data());
+        for (std::size_t i = 0; i < count; ++i)
+            cursor = put_sample(cursor, i);
+
+        return needed;
+    }
+
+    // NOTE: Accumulates bytes into fixed width hex lines for the log
+    class HexLines
+    {
+    public:
+        void write(const std::uint8_t *data, std::size_t length)
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                std::snprintf(line + 2 * used, 3, "%02x", data[i]);
+                if (++used == line_bytes)
+                    flush();
+            }
+        }
+
+        void flush()
+        {
+            if (used)
+                ESP_LOGI(TAG, "GCAP:%.*s", static_cast<int>(2 * used), line);
+            used = 0;
+        }
+
+    private:
+        static constexpr std::size_t line_bytes{32};
+
+        char line[2 * line_bytes + 1]{};
+        std::size_t used{0};
+    };
+
+    void Capture::dump() const
+    {
+        const auto count = size();
+        ESP_LOGI(TAG, "%zu samples, trigger at %ld", count, static_cast<long>(trigger_index()));
+
+        // NOTE: A sample at a time, so dumping doesn't need a buffer for the whole capture
+        std::array<std::uint8_t, std::max(header_size, sample_size)> scratch{};
+        HexLines lines{};
+
+        lines.write(scratch.data(), put_header(scratch.data()) - scratch.data());
+        for (std::size_t i = 0; i < count; ++i)
+            lines.write(scratch.data(), put_sample(scratch.data(), i) - scratch.data());
+
+        lines.flush();
+    }
+
+} // namespace gpio
\ No newline at end of file
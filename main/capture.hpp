@@ -0,0 +1,130 @@
+#pragma once
+
+#include "esp_attr.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace gpio
+{
+
+    struct CaptureSample
+    {
+        std::int64_t timestamp_us;
+        std::uint64_t changed; // NOTE: Captured pins whose edge caused this sample
+        std::uint64_t levels;  // NOTE: Captured pins' levels after the edge
+    };
+
+    template <std::size_t Depth>
+    using CaptureStorage = std::array<CaptureSample, Depth>;
+
+    struct CaptureTrigger
+    {
+        std::uint64_t mask{0};   // NOTE: Zero triggers on the first edge
+        std::uint64_t levels{0}; // NOTE: Fires on an edge of a mask pin that leaves (levels & mask) == this
+    };
+
+    // NOTE: Logic-analyser style capture into caller-provided storage. record() is called from the ISR and only writes the ring and a few
+    // words of state; pre-trigger samples are kept circularly until the trigger, then post samples are taken and the capture freezes.
+    class Capture
+    {
+    public:
+        enum class State : std::uint8_t
+        {
+            Idle,
+            Armed,
+            Triggered,
+            Done,
+        };
+
+        static constexpr std::uint32_t no_trigger{UINT32_MAX};
+
+        Capture(std::span<CaptureSample> storage, std::uint64_t pins) : ring{storage}, pins{pins} {}
+
+        Capture(const Capture &) = delete;
+        Capture &operator=(const Capture &) = delete;
+
+        // NOTE: pre + 1 + post must fit the storage
+        void arm(CaptureTrigger trigger, std::size_t pre, std::size_t post);
+
+        // NOTE: Freezes the capture from a task; waits out an ISR that is mid-record
+        void stop();
+
+        IRAM_ATTR void record(std::int64_t now_us, std::uint64_t changed, std::uint64_t levels)
+        {
+            changed &= pins;
+            if (not changed)
+                return;
+
+            recording.store(true);
+
+            const auto current = state.load();
+            if (State::Armed == current or State::Triggered == current)
+            {
+                const auto position = head;
+                ring[position] = {now_us, changed, levels & pins};
+                head = position + 1 == ring.size() ? 0 : position + 1;
+
+                if (State::Armed == current)
+                {
+                    if (written < ring.size())
+                        ++written;
+
+                    if (0 == trigger.mask or ((changed & trigger.mask) and (levels & trigger.mask) == trigger.levels))
+                    {
+                        triggered = true;
+                        trigger_position = position;
+                        pre_count = std::min(written - 1, pre);
+                        remaining = post;
+                        state.store(0 == remaining ? State::Done : State::Triggered);
+                    }
+                }
+                else if (0 == --remaining)
+                    state.store(State::Done);
+            }
+
+            recording.store(false);
+        }
+
+        [[nodiscard]] State get_state() const { return state.load(); }
+        [[nodiscard]] std::uint64_t get_pins() const { return pins; }
+
+        // NOTE: Only valid once Done; samples come out oldest first
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] std::uint32_t trigger_index() const;
+        [[nodiscard]] const CaptureSample &operator[](std::size_t index) const;
+
+        // NOTE: Compact "GCAP" binary form read by tools/gpiocap_to_vcd.py; returns the bytes needed, writing nothing if out is too small
+        std::size_t export_binary(std::span<std::uint8_t> out) const;
+
+        // NOTE: Logs the export as hex lines prefixed "GCAP:", which the converter also accepts
+        void dump() const;
+
+    private:
+        std::span<CaptureSample> ring;
+        std::uint64_t pins;
+
+        std::atomic<State> state{State::Idle};
+        std::atomic<bool> recording{false}; // NOTE: seq_cst with state so stop() can wait out an ISR on the other core
+        CaptureTrigger trigger{};
+        std::size_t pre{0};
+        std::size_t post{0};
+
+        std::size_t head{0};
+        std::size_t written{0};
+        std::size_t pre_count{0};
+        std::size_t remaining{0};
+        std::size_t trigger_position{0};
+        bool triggered{false};
+
+        [[nodiscard]] std::size_t first() const;
+        [[nodiscard]] std::int64_t start_us() const;
+        std::uint8_t *put_header(std::uint8_t *out) const;
+        std::uint8_t *put_sample(std::uint8_t *out, std::size_t index) const;
+    };
+
+} // namespace gpio
\ No newline at end of file
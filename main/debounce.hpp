@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esp_attr.h"
+
+#include <cstdint>
+
+namespace gpio
+{
+
+    // NOTE: Dead-time debouncer cheap enough to run in the ISR. An edge is accepted once the dead-time since the last accepted edge has
+    // passed and, when tracking levels (any-edge interrupts), only if the sampled level differs from the last accepted one. The raw level
+    // is tracked too: if it settled at the opposite level for a dead-time before coming back, that was a real change whose edge fell inside
+    // the dead-time, so the edge back is accepted even though its level repeats the last accepted one.
+    class Debouncer
+    {
+    public:
+        constexpr Debouncer() = default;
+        constexpr Debouncer(std::int64_t deadtime_us, bool track_level) : deadtime_us{deadtime_us}, track_level{track_level} {}
+
+        [[nodiscard]] IRAM_ATTR constexpr bool accept(std::int64_t now_us, int level) noexcept
+        {
+            const auto settled_opposite = raw_level != level and (now_us - raw_us) >= deadtime_us;
+            if (raw_level != level)
+            {
+                raw_level = level;
+                raw_us = now_us;
+            }
+
+            if (primed and ((now_us - last_us) < deadtime_us or (track_level and level == last_level and not settled_opposite)))
+            {
+                ++rejected_count;
+                return false;
+            }
+
+            primed = true;
+            last_us = now_us;
+            last_level = level;
+            return true;
+        }
+
+        constexpr void reset() noexcept { primed = false; }
+
+        [[nodiscard]] constexpr std::int64_t deadtime() const noexcept { return deadtime_us; }
+        [[nodiscard]] constexpr std::uint32_t rejected() const noexcept { return rejected_count; }
+
+    private:
+        std::int64_t deadtime_us{0};
+        bool track_level{false};
+        bool primed{false};
+        std::int64_t last_us{0};
+        int last_level{0};
+        int raw_level{0}; // NOTE: Of the last edge seen, accepted or not
+        std::int64_t raw_us{0};
+        std::uint32_t rejected_count{0};
+    };
+
+} // namespace gpio
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace gpio
+{
+
+    enum class Gesture : std::uint8_t
+    {
+        None,
+        Click,
+        DoubleClick,
+        LongPress,
+        Repeat, // NOTE: Emitted every repeat interval while held after a long press
+    };
+
+    [[nodiscard, gnu::const]] static constexpr std::string_view gesture_to_string(Gesture gesture)
+    {
+        switch (gesture)
+        {
+        case Gesture::None:
+            return "None";
+        case Gesture::Click:
+            return "Click";
+        case Gesture::DoubleClick:
+            return "DoubleClick";
+        case Gesture::LongPress:
+            return "LongPress";
+        case Gesture::Repeat:
+            return "Repeat";
+        [[unlikely]] default:
+            return "Unknown";
+        }
+    }
+
+    struct GestureTiming
+    {
+        std::int64_t double_click_gap_us{300'000}; // NOTE: Max release-to-press gap for the second click
+        std::int64_t long_press_us{1'000'000};
+        std::int64_t repeat_interval_us{200'000};
+    };
+
+    // NOTE: Table-driven button state machine fed with debounced, timestamped levels. It has no clock of its own: the caller feeds edges,
+    // then polls once next_deadline() passes. Nothing is allocated and the same trace always gives the same gestures, so it runs on the host.
+    class GestureEngine
+    {
+        enum State : std::uint8_t
+        {
+            Idle,
+            FirstDown,
+            FirstUp,
+            SecondDown,
+            Held,
+            StateCount,
+        };
+
+        enum Input : std::uint8_t
+        {
+            Press,
+            Release,
+            Timeout,
+            InputCount,
+        };
+
+        struct Transition
+        {
+            State next;
+            Gesture emit;
+        };
+
+        static constexpr std::array<std::array<Transition, InputCount>, StateCount> table{{
+            //              Press                         Release                            Timeout
+            /* Idle */      {{{FirstDown, Gesture::None}, {Idle, Gesture::None},             {Idle, Gesture::None}}},
+            /* FirstDown */ {{{FirstDown, Gesture::None}, {FirstUp, Gesture::None},          {Held, Gesture::LongPress}}},
+            /* FirstUp */   {{{SecondDown, Gesture::None}, {FirstUp, Gesture::None},         {Idle, Gesture::Click}}},
+            /* SecondDown */{{{SecondDown, Gesture::None}, {Idle, Gesture::DoubleClick},     {SecondDown, Gesture::None}}},
+            /* Held */      {{{Held, Gesture::None},      {Idle, Gesture::None},             {Held, Gesture::Repeat}}},
+        }};
+
+    public:
+        constexpr explicit GestureEngine(GestureTiming timing = {}) : timing{timing} {}
+
+        // NOTE: Applies any timeout that fell due before now_us first, so fn may be called twice. The debouncer only repeats a level once the
+        // opposite one held for a dead-time in between, so a repeat means the edge into that level was lost and it is replayed first. Not
+        // from Idle, where the first edge after start-up may well be a release.
+        template <class Fn>
+        constexpr void feed(std::int64_t now_us, bool pressed, Fn &&fn)
+        {
+            poll(now_us, fn);
+            if (pressed == this->pressed() and Idle != state)
+                step(pressed ? Release : Press, now_us, fn);
+            step(pressed ? Press : Release, now_us, fn);
+        }
+
+        // NOTE: For when an edge's dead-time runs out: feeds the level read off the pin if it differs from the engine's, so a change the
+        // debouncer dropped is picked up straight away instead of at the next deadline
+        template <class Fn>
+        constexpr void settle(std::int64_t now_us, bool pressed_now, Fn &&fn)
+        {
+            if (pressed_now != pressed())
+                feed(now_us, pressed_now, fn);
+        }
+
+        template <class Fn>
+        constexpr void poll(std::int64_t now_us, Fn &&fn)
+        {
+            while (deadline_us and *deadline_us <= now_us)
+                step(Timeout, *deadline_us, fn);
+        }
+
+        // NOTE: Same, but checks the level read off the pin now before acting on a due timeout. A debouncer can drop a real release (one
+        // inside its dead-time), and without this the engine would sit in FirstDown and report a LongPress for a button already let go.
+        // Only releases are recovered: a press the engine hasn't seen yet is more likely still in the queue than lost.
+        template <class Fn>
+        constexpr void poll(std::int64_t now_us, bool pressed_now, Fn &&fn)
+        {
+            if (deadline_us and *deadline_us <= now_us and pressed() and not pressed_now)
+                step(Release, now_us, fn); // NOTE: It happened at some point before now
+            poll(now_us, fn);
+        }
+
+        [[nodiscard]] constexpr std::optional<std::int64_t> next_deadline() const { return deadline_us; }
+        [[nodiscard]] constexpr bool pressed() const { return FirstDown == state or SecondDown == state or Held == state; }
+
+        constexpr void reset()
+        {
+            state = Idle;
+            deadline_us.reset();
+        }
+
+    private:
+        template <class Fn>
+        constexpr void step(Input input, std::int64_t at_us, Fn &fn)
+        {
+            const auto [next, emit] = table[state][input];
+            const auto entered = next != state;
+            state = next;
+
+            if (entered or Timeout == input)
+                arm(at_us);
+
+            if (Gesture::None != emit)
+                fn(emit, at_us);
+        }
+
+        // NOTE: Deadlines are relative to the edge or timeout that entered the state, so repeats don't drift with polling latency
+        constexpr void arm(std::int64_t from_us)
+        {
+            switch (state)
+            {
+            case FirstDown:
+                deadline_us = from_us + timing.long_press_us;
+                break;
+            case FirstUp:
+                deadline_us = from_us + timing.double_click_gap_us;
+                break;
+            case Held:
+                deadline_us = from_us + timing.repeat_interval_us;
+                break;
+            default:
+                deadline_us.reset();
+                break;
+            }
+        }
+
+        GestureTiming timing;
+        State state{Idle};
+        std::optional<std::int64_t> deadline_us{};
+    };
+
+} // namespace gpio
\ No newline at end of file
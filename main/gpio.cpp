@@ -3,24 +3,100 @@
 
 #include "gpio.hpp"
 
+#include "esp_ipc.h"
+
+#include <mutex>
+
 namespace gpio
 {
 
-    std::unordered_set<gpio_num_t> GpioBase::used_pins{};
-    std::unordered_map<gpio_num_t, gpio_config_t> GpioBase::configs{};
-    std::mutex GpioBase::mutex{};
+    std::array<GpioBase::PinSlot, GPIO_NUM_MAX> GpioBase::pins{};
+    DRAM_ATTR std::array<IsrArgs, GPIO_NUM_MAX> GpioBase::isr_slots{};
+
+    // NOTE: Pin slot writes happen in task context under this, so a higher priority find_config() on the same core can never preempt a
+    // half-written slot and spin on it forever; readers on the other core only spin for as long as the copy takes
+    static portMUX_TYPE pins_lock = portMUX_INITIALIZER_UNLOCKED;
+
+    // NOTE: Guards the GPIO interrupt source's ownership; only taken in task context, when handlers and dispatchers come and go
+    static std::mutex interrupt_mutex{};
+    static std::size_t isr_handlers{0};
+    static bool port_interrupt_claimed{false};
+
+    static void noop(void *) {}
+
+    void GpioBase::wait_for_isrs()
+    {
+#ifndef CONFIG_FREERTOS_UNICORE
+        // NOTE: This core is in task context so it can't be in the ISR; the IPC task only runs on the other core once its ISRs have returned
+        esp_ipc_call_blocking(xPortGetCoreID() ? 0 : 1, noop, nullptr);
+#endif
+    }
+
+    esp_err_t GpioBase::add_isr_handler(gpio_num_t pin, gpio_isr_t isr, void *arg)
+    {
+        std::scoped_lock lock{interrupt_mutex};
+
+        if (port_interrupt_claimed)
+        {
+            ESP_LOGE(TAG, "GPIO[%d] can't have an ISR, a PortDispatcher owns the GPIO interrupt", pin);
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        if (0 == isr_handlers)
+            if (const auto err = gpio_install_isr_service(0); ESP_OK != err and ESP_ERR_INVALID_STATE != err) // NOTE: Or already installed
+                return err;
+
+        if (const auto err = gpio_isr_handler_add(pin, isr, arg); ESP_OK != err)
+        {
+            if (0 == isr_handlers)
+                gpio_uninstall_isr_service();
+            return err;
+        }
+
+        ++isr_handlers;
+        return ESP_OK;
+    }
+
+    void GpioBase::remove_isr_handler(gpio_num_t pin)
+    {
+        std::scoped_lock lock{interrupt_mutex};
+
+        gpio_isr_handler_remove(pin);
+
+        assert(isr_handlers);
+        if (0 == --isr_handlers)
+            gpio_uninstall_isr_service(); // NOTE: Hands the interrupt source back, so a PortDispatcher can take it
+    }
+
+    esp_err_t GpioBase::claim_port_interrupt()
+    {
+        std::scoped_lock lock{interrupt_mutex};
+
+        if (port_interrupt_claimed or isr_handlers)
+            return ESP_ERR_INVALID_STATE;
+
+        // NOTE: Probe, since anything outside these wrappers may have installed the service too
+        if (const auto err = gpio_install_isr_service(0); ESP_OK != err)
+            return err;
+        gpio_uninstall_isr_service();
+
+        port_interrupt_claimed = true;
+        return ESP_OK;
+    }
+
+    void GpioBase::release_port_interrupt()
+    {
+        std::scoped_lock lock{interrupt_mutex};
+        port_interrupt_claimed = false;
+    }
 
-    GpioBase::GpioBase(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr, void *isr_args) : pin{pin}, isr{isr}, isr_args{pin, config, {}, isr_args}
+    GpioBase::GpioBase(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr, void *isr_args, std::chrono::microseconds debounce)
+        : pin{pin}, isr{isr}
     {
         assert(GPIO_IS_VALID_GPIO(pin));
-        std::scoped_lock _(mutex);
-        assert(used_pins.find(pin) == used_pins.end());
-        assert(configs.find(pin) == configs.end());
-        const auto [piniter, pinsuccess] = used_pins.insert(pin);
-        assert(pinsuccess);
         assert(not config_is_empty(config));
-        const auto [configiter, configsuccess] = configs.insert({pin, config});
-        assert(configsuccess);
+        const auto claimed = claim(pin, config);
+        assert(claimed);
 
         ESP_LOGI(TAG, "Registered GPIO[%d]", pin);
 
@@ -28,51 +104,105 @@ namespace gpio
 
         if (isr)
         {
-            isr_queue = queue::make_sharablequeue<IsrRet>();
+            isr_queue = queue::make_ringqueue<IsrRet, isr_queue_depth>();
             assert(isr_queue);
-            this->isr_args.queue = isr_queue;
 
-            auto installsuccess = gpio_install_isr_service(0);
-            assert(ESP_OK == installsuccess || ESP_ERR_INVALID_STATE == installsuccess); // NOTE: Installed or already installed
-            ESP_ERROR_CHECK(gpio_isr_handler_add(pin, isr, &this->isr_args));
+            auto &slot = isr_slots[pin];
+            assert(not slot.live());
+            slot.pin = pin;
+            slot.config = config;
+            slot.queue = isr_queue.get();
+            slot.isr_args = isr_args;
+            slot.debounce = {debounce.count(), GPIO_INTR_ANYEDGE == config.intr_type};
+            slot.generation.fetch_add(1, std::memory_order_release); // NOTE: Publish as live
+
+            ESP_ERROR_CHECK(add_isr_handler(pin, isr, &slot));
         }
     }
 
     GpioBase::~GpioBase()
     {
-        std::scoped_lock _(mutex);
-
         if (isr)
-            gpio_isr_handler_remove(pin);
+        {
+            isr_slots[pin].generation.fetch_add(1, std::memory_order_release); // NOTE: Retire; ISRs from here on see no queue
+            remove_isr_handler(pin);
+            wait_for_isrs(); // NOTE: Only now is it safe for isr_queue to be destroyed
+        }
 
         gpio_reset_pin(pin);
 
-        assert(used_pins.find(pin) != used_pins.end());
-        assert(configs.find(pin) != configs.end());
-        const auto configerased = configs.erase(pin);
-        assert(configerased);
-        const auto pinerased = used_pins.erase(pin);
-        assert(pinerased);
+        assert(in_use(pin));
+        release(pin);
 
         ESP_LOGI(TAG, "Unregistered GPIO[%d]", pin);
     }
 
+    bool GpioBase::claim(gpio_num_t pin, const gpio_config_t &config)
+    {
+        auto &slot = pins[pin];
+
+        if (slot.claimed.exchange(true, std::memory_order_acquire))
+            return false;
+
+        portENTER_CRITICAL(&pins_lock);
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.config = config;
+        slot.configured = true;
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        portEXIT_CRITICAL(&pins_lock);
+
+        return true;
+    }
+
+    void GpioBase::release(gpio_num_t pin)
+    {
+        auto &slot = pins[pin];
+
+        portENTER_CRITICAL(&pins_lock);
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.configured = false;
+        slot.config = {};
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        portEXIT_CRITICAL(&pins_lock);
+
+        slot.claimed.store(false, std::memory_order_release);
+    }
+
     bool GpioBase::in_use(gpio_num_t pin)
     {
-        std::scoped_lock _(mutex);
-        const bool is_used = used_pins.find(pin) != used_pins.end();
-        const bool is_configured = configs.find(pin) != configs.end();
-        assert(is_used == is_configured);
-        return is_used;
+        if (not GPIO_IS_VALID_GPIO(pin))
+            return false;
+
+        return pins[pin].claimed.load(std::memory_order_acquire);
     }
 
     std::optional<gpio_config_t> GpioBase::find_config(gpio_num_t pin)
     {
-        if (not in_use(pin))
+        if (not GPIO_IS_VALID_GPIO(pin))
             return {};
 
-        std::scoped_lock _(mutex);
-        return {configs.find(pin)->second};
+        const auto &slot = pins[pin];
+        while (true)
+        {
+            const auto before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1)
+                continue;
+
+            const bool configured = slot.configured;
+            const gpio_config_t config = slot.config;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (before != slot.sequence.load(std::memory_order_relaxed))
+                continue;
+
+            if (not configured)
+                return {};
+            return {config};
+        }
     }
 
 } // namespace gpio
\ No newline at end of file
@@ -1,18 +1,24 @@
 #pragma once
 
+#include "debounce.hpp"
+#include "portwriter.hpp"
 #include "singleton.hpp"
 #include "wrappers/sharablequeue.hpp"
 
 #include "driver/gpio.h"
 #include "esp_system.h"
-
+#include "esp_timer.h"
+#include "hal/gpio_ll.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 
 static constexpr bool operator==(const gpio_config_t &lhs, const gpio_config_t &rhs) noexcept
 {
@@ -49,26 +55,57 @@ namespace gpio
     [[nodiscard, gnu::const]] static constexpr bool config_is_empty(const gpio_config_t &config) noexcept
     {
         constexpr auto empty = gpio_config_t{};
-        return config != empty;
+        return config == empty;
     }
 
     struct IsrRet
     {
         gpio_num_t pin;
         gpio_int_type_t state{gpio_int_type_t::GPIO_INTR_DISABLE};
+        std::int64_t timestamp_us{0}; // NOTE: esp_timer time of the interrupt
+        int level{0};                 // NOTE: Pin level sampled in the ISR
     };
 
-    using IsrQueue = queue::SharableQueue<IsrRet>;
+    static constexpr std::size_t isr_queue_depth{32};
+
+    using IsrQueue = queue::RingQueue<IsrRet, isr_queue_depth>;
 
+    // NOTE: Per-pin ISR context living in a static table, so the handler argument can never dangle. The ISR only does plain loads: it checks
+    // the generation is odd (live) and uses the raw queue pointer, which GpioBase keeps alive until a grace period after retiring the slot.
     struct IsrArgs
     {
-        gpio_num_t pin;
-        gpio_config_t config; // TODO merge or reference with map
-        std::weak_ptr<IsrQueue> queue{};
-        void *isr_args;
+        gpio_num_t pin{GPIO_NUM_NC};
+        gpio_config_t config{};
+        std::atomic<std::uint32_t> generation{0};
+        IsrQueue *queue{nullptr};
+        void *isr_args{nullptr};
+        Debouncer debounce{};
+
+        [[nodiscard]] IRAM_ATTR bool live() const { return generation.load(std::memory_order_acquire) & 1; }
+        [[nodiscard]] IRAM_ATTR IsrQueue *get_queue() const { return live() ? queue : nullptr; }
+
+        // NOTE: Timestamps and samples the pin, then runs the debouncer; call first thing in the ISR and drop the edge if it returns false
+        [[nodiscard]] IRAM_ATTR bool sample(IsrRet &event)
+        {
+            const auto now = esp_timer_get_time();
+            const auto level = gpio_ll_get_level(&GPIO, pin);
+
+            if (not debounce.accept(now, level))
+                return false;
+
+            event = {pin, config.intr_type, now, level};
+            return true;
+        }
     };
 
     class Gpio;
+    class PortDispatcher;
+    class PulseInput;
+
+    using StaticIsr = void (*)(const IsrRet &);
+
+    template <gpio_num_t PIN, gpio_config_t CONFIG, StaticIsr ISR>
+    class StaticGpio;
 
     class GpioBase : public Singleton<GpioBase> // NOTE: CRTP
     {
@@ -84,10 +121,35 @@ namespace gpio
     protected:
         friend Singleton<GpioBase>; // NOTE: So Singleton can use our private/protected constructor
         friend Gpio;
+        friend PortDispatcher;
+        friend PulseInput;
+        template <gpio_num_t PIN, gpio_config_t CONFIG, StaticIsr ISR>
+        friend class StaticGpio;
+
+        // NOTE: One slot per pin; claimed is the registration lock, the config behind it is published with a seqlock so reads never block
+        struct PinSlot
+        {
+            std::atomic<bool> claimed{false};
+            std::atomic<std::uint32_t> sequence{0}; // NOTE: Odd while the slot is being written
+            bool configured{false};
+            gpio_config_t config{};
+        };
+
+        static std::array<PinSlot, GPIO_NUM_MAX> pins;
+
+        [[nodiscard]] static bool claim(gpio_num_t pin, const gpio_config_t &config);
+        static void release(gpio_num_t pin);
 
-        static std::unordered_set<gpio_num_t> used_pins;
-        static std::unordered_map<gpio_num_t, gpio_config_t> configs;
-        static std::mutex mutex;
+        // NOTE: Returns once no ISR that may have seen a removed handler or retired slot can still be running, so its argument can be freed
+        static void wait_for_isrs();
+
+        // NOTE: The GPIO interrupt source belongs either to the per-pin ISR service or to one PortDispatcher, never both: whichever took it
+        // second would silently steal the other's edges. Handlers are added through here so the service can be installed on the first and
+        // uninstalled after the last, and ESP_ERR_INVALID_STATE comes back while a dispatcher owns the source.
+        [[nodiscard]] static esp_err_t add_isr_handler(gpio_num_t pin, gpio_isr_t isr, void *arg);
+        static void remove_isr_handler(gpio_num_t pin);
+        [[nodiscard]] static esp_err_t claim_port_interrupt(); // NOTE: ESP_ERR_INVALID_STATE while the ISR service or another dispatcher has it
+        static void release_port_interrupt();
 
         GpioBase() = delete;
         GpioBase(const GpioBase &) = delete;
@@ -95,13 +157,14 @@ namespace gpio
         GpioBase &operator=(const GpioBase &) = delete;
         GpioBase &operator=(GpioBase &&) = delete;
 
-        GpioBase(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr = nullptr, void *isr_args = nullptr);
+        GpioBase(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr = nullptr, void *isr_args = nullptr, std::chrono::microseconds debounce = std::chrono::microseconds::zero());
 
     private:
         gpio_num_t pin;
         gpio_isr_t isr{nullptr};
-        IsrArgs isr_args{};
         std::shared_ptr<IsrQueue> isr_queue{};
+
+        static std::array<IsrArgs, GPIO_NUM_MAX> isr_slots;
     };
 
     class Gpio
@@ -109,10 +172,78 @@ namespace gpio
         GpioBase::Shared base;
 
     public:
-        Gpio(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr = nullptr, void *isr_args = nullptr) : base{GpioBase::get_shared(pin, config, isr, isr_args)} {}
+        Gpio(gpio_num_t pin, gpio_config_t config, gpio_isr_t isr = nullptr, void *isr_args = nullptr, std::chrono::microseconds debounce = std::chrono::microseconds::zero())
+            : base{GpioBase::get_shared(pin, config, isr, isr_args, debounce)} {}
 
         [[nodiscard]] gpio_num_t get_pin() const { return base->get_pin(); }
         [[nodiscard]] std::shared_ptr<IsrQueue> get_queue() const { return base->get_queue(); }
+
+        [[nodiscard]] int get_level() const { return gpio_get_level(get_pin()); }
+        void set_level(int level) const { gpio_set_level(get_pin(), level); }
+    };
+
+    // NOTE: Pin, config and ISR fixed at compile time. Everything is validated by static_assert and the ISR gets a dedicated trampoline with the
+    // pin baked in, so registration is just the pin table claim plus the driver calls. CONFIG.pin_bit_mask may be left empty.
+    template <gpio_num_t PIN, gpio_config_t CONFIG, StaticIsr ISR = nullptr>
+    class StaticGpio
+    {
+        static_assert(GPIO_IS_VALID_GPIO(PIN), "Invalid GPIO pin");
+        static_assert(0 == CONFIG.pin_bit_mask or (1ULL << PIN) == CONFIG.pin_bit_mask, "pin_bit_mask must be empty or select only PIN");
+        static_assert(not(CONFIG.mode & GPIO_MODE_DEF_OUTPUT) or GPIO_IS_VALID_OUTPUT_GPIO(PIN), "PIN can't be used as an output");
+        static_assert(not(CONFIG.pull_up_en and CONFIG.pull_down_en), "Pull-up and pull-down are both enabled");
+        static_assert(not(CONFIG.pull_up_en or CONFIG.pull_down_en) or GPIO_IS_VALID_OUTPUT_GPIO(PIN), "PIN has no internal pull resistors");
+        static_assert(CONFIG.intr_type < GPIO_INTR_MAX, "Invalid interrupt type");
+        static_assert((nullptr != ISR) == (GPIO_INTR_DISABLE != CONFIG.intr_type), "An ISR needs an interrupt type and vice versa");
+
+    public:
+        static constexpr gpio_num_t pin{PIN};
+        static constexpr std::uint64_t mask{1ULL << PIN};
+        static constexpr gpio_config_t config = []
+        {
+            auto ret = CONFIG;
+            ret.pin_bit_mask = mask;
+            return ret;
+        }();
+
+        StaticGpio()
+        {
+            const auto claimed = GpioBase::claim(PIN, config);
+            assert(claimed);
+
+            gpio_config(&config);
+
+            if constexpr (nullptr != ISR)
+                ESP_ERROR_CHECK(GpioBase::add_isr_handler(PIN, trampoline, nullptr));
+        }
+
+        ~StaticGpio()
+        {
+            if constexpr (nullptr != ISR)
+                GpioBase::remove_isr_handler(PIN);
+
+            gpio_reset_pin(PIN);
+            GpioBase::release(PIN);
+        }
+
+        StaticGpio(const StaticGpio &) = delete;
+        StaticGpio &operator=(const StaticGpio &) = delete;
+
+        [[nodiscard]] IRAM_ATTR static int get_level() { return gpio_ll_get_level(&GPIO, PIN); }
+
+        IRAM_ATTR static void set_level(int level)
+        {
+            static_assert(CONFIG.mode & GPIO_MODE_DEF_OUTPUT, "PIN isn't configured as an output");
+            if (level)
+                PortWriter::write_masks<mask>();
+            else
+                PortWriter::write_masks<0, mask>();
+        }
+
+    private:
+        IRAM_ATTR static void trampoline(void *)
+        {
+            ISR(IsrRet{PIN, CONFIG.intr_type, esp_timer_get_time(), gpio_ll_get_level(&GPIO, PIN)});
+        }
     };
 
 } // namespace gpio
\ No newline at end of file
@@ -1,33 +1,59 @@
 #define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
 #include "esp_log.h"
 
+#include "benchmark.hpp"
+#include "gesture.hpp"
 #include "gpio.hpp"
 #include "smartconfig.hpp"
 #include "wifi.hpp"
 #include "wrappers/nvs.hpp"
+#include "wrappers/stackprofiler.hpp"
 #include "wrappers/task.hpp"
+#include "wrappers/taskstats.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <span>
 #include <utility>
-#include <vector>
 
 // #define CLEAR_WIFI_NVS
+// #define SINGLETON_BENCHMARK
+// #define QUEUE_BATCH_BENCHMARK
+// #define WAKE_LATENCY_BENCHMARK
+// #define PAYLOAD_BENCHMARK
+// #define DISPATCH_BENCHMARK
+// #define EXECUTOR_BENCHMARK
+// #define PERIODIC_BENCHMARK
+// #define TIMER_WHEEL_BENCHMARK
 #define KEEP_WIFI_ALIVE
+// #define STACK_PROFILER
+// #define TASK_STATS
 #define PIN (gpio_num_t::GPIO_NUM_34)
 
 static constexpr const char *TAG = "main";
+static constexpr std::chrono::milliseconds debounce{20};
 
 static void gpio_isr_handler(void *arg)
 {
-    auto args = *reinterpret_cast<gpio::IsrArgs *>(arg);
-    auto queue = args.queue.lock();
+    auto &args = *reinterpret_cast<gpio::IsrArgs *>(arg);
+
+    auto queue = args.get_queue();
+    if (not queue)
+    {
+        ESP_DRAM_LOGE("gpio_isr_handler", "Queue is null");
+        return;
+    }
+
+    gpio::IsrRet event;
+    if (not args.sample(event))
+        return;
 
     ESP_DRAM_LOGD("gpio_isr_handler", "GPIO[%d] ISR", args.pin);
 
-    if (queue)
-        queue->push_from_isr({args.pin, args.config.intr_type});
-    else
-        ESP_DRAM_LOGE("gpio_isr_handler", "Queue is null");
+    queue->push_from_isr(event);
 }
 
 [[nodiscard]] std::pair<std::unique_ptr<gpio::Gpio>, std::shared_ptr<gpio::IsrQueue>> unpack_gpio_task_arg(void *arg)
@@ -57,31 +83,86 @@ static void gpio_isr_handler(void *arg)
     auto wifiobj{wifi::Wifi::get_shared()};
 #endif
 
-    std::vector<SmartConfig> instances;
+    std::optional<SmartConfig> provisioning{};
 
-    while (true)
+    // NOTE: So a later double-click can provision again
+    auto release_if_done = [&provisioning]
     {
-        if (const auto result = queue->pop_wait())
+        if (provisioning and sc::state_t::DONE == (*provisioning)->get_state())
         {
-            const auto &item = result.item;
-            ESP_LOGI(TAG, "GPIO[%d] intr, val: %d, state: %s", item.pin, gpio_get_level(item.pin), gpio::int_type_to_string(item.state).c_str());
+            ESP_LOGI(TAG, "SmartConfig done");
+            provisioning.reset();
+        }
+    };
 
-            if (instances.size() >= 5)
-            {
-                ESP_LOGW(TAG, "Clearing instances and wiping WiFi NVS");
-                auto _wifi = instances.front()->get_wifi();
-                _wifi->nvs_erase();
-                _wifi->disconnect();
-                instances.clear();
-            }
-            else
+    // NOTE: Double-click starts SmartConfig provisioning, long-press wipes the stored credentials. The hold is long enough that a brush
+    // against the button, or a glitch on the pin, can't wipe them.
+    static constexpr gpio::GestureTiming timing{.long_press_us = 5'000'000};
+    auto on_gesture = [&provisioning, &release_if_done](gpio::Gesture gesture, std::int64_t at_us)
+    {
+        ESP_LOGI(TAG, "%s at %lld us", gpio::gesture_to_string(gesture).data(), at_us);
+
+        switch (gesture)
+        {
+        case gpio::Gesture::DoubleClick:
+            release_if_done();
+            if (not provisioning)
             {
-                ESP_LOGI(TAG, "Pushing back instance");
-                instances.push_back(sc::SmartConfig::get_shared());
+                ESP_LOGI(TAG, "Starting SmartConfig");
+                provisioning = sc::SmartConfig::get_shared();
             }
+            break;
+        case gpio::Gesture::LongPress:
+        {
+            ESP_LOGW(TAG, "Wiping WiFi NVS");
+            auto _wifi = provisioning ? (*provisioning)->get_wifi() : wifi::Wifi::get_shared();
+            _wifi->nvs_erase();
+            _wifi->disconnect();
+            provisioning.reset();
+            break;
+        }
+        default:
+            break;
+        }
+    };
+
+    gpio::GestureEngine gestures{timing};
+    std::array<gpio::IsrRet, gpio::isr_queue_depth> batch{};
+    std::optional<std::int64_t> settle_us{}; // NOTE: When the last edge's dead-time runs out, to pick up a change the debouncer dropped
+
+    while (true)
+    {
+        auto deadline = gestures.next_deadline();
+        if (settle_us and (not deadline or *settle_us < *deadline))
+            deadline = settle_us;
+
+        auto wait_for = std::chrono::milliseconds::max();
+        if (deadline)
+        {
+            // NOTE: Rounded up to whole ticks, a few ms would otherwise truncate to a zero tick wait and spin until the deadline
+            static constexpr std::int64_t tick_us{portTICK_PERIOD_MS * 1000};
+            const auto remaining_us = std::max<std::int64_t>(0, *deadline - esp_timer_get_time());
+            wait_for = std::chrono::milliseconds{(remaining_us + tick_us - 1) / tick_us * portTICK_PERIOD_MS};
+        }
+
+        const auto count = queue->pop_wait_batch(batch, wait_for);
+
+        for (const auto &item : std::span{batch}.first(count))
+        {
+            ESP_LOGD(TAG, "GPIO[%d] intr at %lld us, val: %d, state: %s", item.pin, item.timestamp_us, item.level, gpio::int_type_to_string(item.state).c_str());
+            gestures.feed(item.timestamp_us, item.level, on_gesture); // NOTE: Pulled down, so pressed reads high
+            settle_us = item.timestamp_us + std::chrono::microseconds{debounce}.count();
+        }
+
+        const auto now = esp_timer_get_time();
+        if (settle_us and *settle_us <= now)
+        {
+            gestures.settle(now, gpio->get_level(), on_gesture);
+            settle_us.reset();
         }
-        else
-            ESP_LOGI(TAG, "Waiting for interrupt");
+
+        gestures.poll(now, gpio->get_level(), on_gesture); // NOTE: The live level covers edges the debouncer dropped
+        release_if_done();
     }
 }
 
@@ -89,10 +170,52 @@ int main()
 {
     ESP_LOGD(TAG, "C++ entrypoint");
 
+#ifdef STACK_PROFILER
+    task::start_stack_profiler();
+#endif
+
+#ifdef TASK_STATS
+    task::start_task_stats();
+#endif
+
+#ifdef SINGLETON_BENCHMARK
+    benchmark::singleton_contention();
+#endif
+
+#ifdef QUEUE_BATCH_BENCHMARK
+    benchmark::queue_batching();
+#endif
+
+#ifdef WAKE_LATENCY_BENCHMARK
+    benchmark::wake_latency();
+#endif
+
+#ifdef PAYLOAD_BENCHMARK
+    benchmark::payload_throughput();
+#endif
+
+#ifdef DISPATCH_BENCHMARK
+    benchmark::dispatch_cycles();
+#endif
+
+#ifdef EXECUTOR_BENCHMARK
+    benchmark::executor_scaling();
+#endif
+
+#ifdef PERIODIC_BENCHMARK
+    benchmark::periodic_jitter();
+#endif
+
+#ifdef TIMER_WHEEL_BENCHMARK
+    benchmark::timer_wheel();
+#endif
+
     static_assert(GPIO_IS_VALID_GPIO(PIN), "Invalid GPIO pin");
 
-    auto gpioargs = new gpio::Gpio{PIN, gpio_config_t{.pin_bit_mask = 1ULL << PIN, .mode = GPIO_MODE_INPUT, .pull_up_en = GPIO_PULLUP_DISABLE, .pull_down_en = GPIO_PULLDOWN_ENABLE, .intr_type = GPIO_INTR_NEGEDGE}, gpio_isr_handler};
-    auto gpio_task = task::make_task(gpio_main, "gpio_main", 4096, gpioargs, 10);
+    // NOTE: GPIO34-39 have no internal pulls, so the button relies on a pull-down on the board
+    auto gpioargs = new gpio::Gpio{PIN, gpio_config_t{.pin_bit_mask = 1ULL << PIN, .mode = GPIO_MODE_INPUT, .pull_up_en = GPIO_PULLUP_DISABLE, .pull_down_en = GPIO_PULLDOWN_DISABLE, .intr_type = GPIO_INTR_ANYEDGE}, gpio_isr_handler, nullptr, debounce};
+    static task::TaskStorage<4096> gpio_task_storage;
+    auto gpio_task = task::make_task_static(gpio_task_storage, gpio_main, "gpio_main", gpioargs, 10);
 
     if (not gpio_task)
     {
@@ -0,0 +1,136 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#include "esp_log.h"
+
+#include "portdispatcher.hpp"
+
+#include "esp_timer.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
+
+#include <utility>
+
+namespace gpio
+{
+
+    [[nodiscard, gnu::const]] static constexpr bool selects(std::uint64_t mask, int pin) noexcept
+    {
+        return mask & (1ULL << pin);
+    }
+
+    std::unique_ptr<PortDispatcher> make_port_dispatcher(gpio_config_t config)
+    {
+        assert(config.pin_bit_mask);
+        assert(0 == (config.pin_bit_mask & ~SOC_GPIO_VALID_GPIO_MASK));
+        assert(GPIO_INTR_DISABLE != config.intr_type);
+
+        std::unique_ptr<PortDispatcher> dispatcher{new PortDispatcher{config.pin_bit_mask}};
+
+        if (const auto err = dispatcher->attach(config); ESP_OK != err)
+        {
+            ESP_LOGE(TAG, "Port dispatcher for mask 0x%llx failed: %s", config.pin_bit_mask, esp_err_to_name(err));
+            return nullptr;
+        }
+
+        ESP_LOGI(TAG, "Port dispatcher registered for mask 0x%llx", config.pin_bit_mask);
+        return dispatcher;
+    }
+
+    PortDispatcher::PortDispatcher(std::uint64_t mask) : mask{mask}, queue{queue::make_ringqueue<PortEvent, port_queue_depth>()}, isr_queue{queue.get()} {}
+
+    PortDispatcher::~PortDispatcher()
+    {
+        const auto attached = 0 != claimed;
+        detach();
+
+        if (attached)
+            ESP_LOGI(TAG, "Port dispatcher unregistered for mask 0x%llx", mask);
+    }
+
+    esp_err_t PortDispatcher::attach(const gpio_config_t &config)
+    {
+        for (int pin = 0; pin < GPIO_NUM_MAX; ++pin)
+        {
+            if (not selects(mask, pin))
+                continue;
+
+            if (not GpioBase::claim(static_cast<gpio_num_t>(pin), config))
+            {
+                ESP_LOGE(TAG, "GPIO[%d] is already in use", pin);
+                detach();
+                return ESP_ERR_INVALID_STATE;
+            }
+            claimed |= 1ULL << pin;
+        }
+
+        if (const auto err = GpioBase::claim_port_interrupt(); ESP_OK != err)
+        {
+            ESP_LOGE(TAG, "The GPIO interrupt is already taken by the ISR service or another port dispatcher");
+            detach();
+            return err;
+        }
+
+        // NOTE: IRAM, like the dispatch path, so edges are still handled while flash is busy
+        if (const auto err = gpio_isr_register(isr, this, ESP_INTR_FLAG_IRAM, &handle); ESP_OK != err)
+        {
+            GpioBase::release_port_interrupt();
+            detach();
+            return err;
+        }
+
+        if (const auto err = gpio_config(&config); ESP_OK != err)
+        {
+            detach();
+            return err;
+        }
+
+        return ESP_OK;
+    }
+
+    void PortDispatcher::detach()
+    {
+        if (handle)
+        {
+            for (int pin = 0; pin < GPIO_NUM_MAX; ++pin)
+                if (selects(mask, pin))
+                    gpio_intr_disable(static_cast<gpio_num_t>(pin));
+
+            esp_intr_free(std::exchange(handle, nullptr));
+            GpioBase::release_port_interrupt();
+        }
+
+        for (int pin = 0; pin < GPIO_NUM_MAX; ++pin)
+        {
+            if (not selects(claimed, pin))
+                continue;
+            gpio_reset_pin(static_cast<gpio_num_t>(pin));
+            GpioBase::release(static_cast<gpio_num_t>(pin));
+        }
+        claimed = 0;
+    }
+
+    IRAM_ATTR void PortDispatcher::isr(void *arg)
+    {
+        auto &self = *static_cast<PortDispatcher *>(arg);
+
+        const auto core = xPortGetCoreID();
+        std::uint32_t low{0};
+        std::uint32_t high{0};
+        gpio_ll_get_intr_status(&GPIO, core, &low);
+        gpio_ll_get_intr_status_high(&GPIO, core, &high);
+        gpio_ll_clear_intr_status(&GPIO, low);
+        gpio_ll_clear_intr_status_high(&GPIO, high);
+
+        const auto changed = ((std::uint64_t{high} << 32) | low) & self.mask;
+        if (not changed)
+            return;
+
+        const auto levels = (std::uint64_t{GPIO.in1.data} << 32) | GPIO.in;
+        const auto now = esp_timer_get_time();
+
+        if (auto capture = self.capture.load(std::memory_order_acquire))
+            capture->record(now, changed, levels);
+
+        self.isr_queue->push_from_isr({changed, levels, now});
+    }
+
+} // namespace gpio
\ No newline at end of file
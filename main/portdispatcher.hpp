@@ -0,0 +1,71 @@
+#pragma once
+
+#include "capture.hpp"
+#include "gpio.hpp"
+#include "wrappers/sharablequeue.hpp"
+
+#include "driver/gpio.h"
+#include "esp_system.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gpio
+{
+
+    struct PortEvent
+    {
+        std::uint64_t changed;     // NOTE: Every pin whose interrupt was pending
+        std::uint64_t levels;      // NOTE: The whole input port, read once
+        std::int64_t timestamp_us; // NOTE: esp_timer time of the interrupt
+    };
+
+    static constexpr std::size_t port_queue_depth{32};
+
+    using PortQueue = queue::RingQueue<PortEvent, port_queue_depth>;
+
+    class PortDispatcher;
+
+    // NOTE: config.pin_bit_mask selects the pins. Returns nullptr, with nothing left claimed, if a pin is already in use, the GPIO interrupt
+    // is taken by the per-pin ISR service or another dispatcher, or it can't be allocated.
+    [[nodiscard]] std::unique_ptr<PortDispatcher> make_port_dispatcher(gpio_config_t config);
+
+    // NOTE: Port-level alternative to per-pin handlers. One ISR reads the interrupt status and input registers once and emits a single bitmask
+    // event for every pin that fired together. It owns the GPIO interrupt, so it can't be mixed with the per-pin ISR service (a Gpio with an
+    // isr, a StaticGpio with an ISR or a PulseInput); whichever comes second is refused.
+    class PortDispatcher
+    {
+    public:
+        ~PortDispatcher();
+
+        PortDispatcher(const PortDispatcher &) = delete;
+        PortDispatcher &operator=(const PortDispatcher &) = delete;
+
+        [[nodiscard]] std::uint64_t get_mask() const { return mask; }
+        [[nodiscard]] std::shared_ptr<PortQueue> get_queue() const { return queue; }
+
+        // NOTE: Every edge is also recorded into capture, even when the queue is full. The capture must outlive the attachment; pass nullptr to
+        // detach it.
+        void set_capture(Capture *capture) { this->capture.store(capture, std::memory_order_release); }
+
+    private:
+        friend std::unique_ptr<PortDispatcher> make_port_dispatcher(gpio_config_t config);
+
+        explicit PortDispatcher(std::uint64_t mask);
+
+        [[nodiscard]] esp_err_t attach(const gpio_config_t &config);
+        void detach();
+
+        static void isr(void *arg);
+
+        std::uint64_t mask;
+        std::uint64_t claimed{0}; // NOTE: The pins this instance holds in the GpioBase table, so a failed attach releases only its own
+        std::shared_ptr<PortQueue> queue;
+        PortQueue *isr_queue; // NOTE: Raw copy so the ISR doesn't touch the shared_ptr
+        gpio_isr_handle_t handle{nullptr};
+        std::atomic<Capture *> capture{nullptr};
+    };
+
+} // namespace gpio
\ No newline at end of file
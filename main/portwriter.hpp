@@ -0,0 +1,91 @@
+#pragma once
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "hal/gpio_ll.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace gpio
+{
+
+    // NOTE: Collects set/clear masks for output pins and commits them with one store per W1TS/W1TC register, so every pin in a bank changes in
+    // the same cycle. Pins must already be configured as outputs; nothing here touches the pin table or the driver.
+    class PortWriter
+    {
+    public:
+        PortWriter &set(gpio_num_t pin)
+        {
+            assert(GPIO_IS_VALID_OUTPUT_GPIO(pin));
+            return set_mask(1ULL << pin);
+        }
+
+        PortWriter &clear(gpio_num_t pin)
+        {
+            assert(GPIO_IS_VALID_OUTPUT_GPIO(pin));
+            return clear_mask(1ULL << pin);
+        }
+
+        PortWriter &write(gpio_num_t pin, int level) { return level ? set(pin) : clear(pin); }
+
+        // NOTE: The last request for a pin wins
+        PortWriter &set_mask(std::uint64_t mask)
+        {
+            set_bits |= mask;
+            clear_bits &= ~mask;
+            return *this;
+        }
+
+        PortWriter &clear_mask(std::uint64_t mask)
+        {
+            clear_bits |= mask;
+            set_bits &= ~mask;
+            return *this;
+        }
+
+        [[nodiscard]] bool pending() const { return set_bits or clear_bits; }
+
+        IRAM_ATTR void commit()
+        {
+            write_masks(set_bits, clear_bits);
+            set_bits = clear_bits = 0;
+        }
+
+        IRAM_ATTR static void write_masks(std::uint64_t set, std::uint64_t clear)
+        {
+            assert(0 == ((set | clear) & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK));
+
+            if (const auto low = static_cast<std::uint32_t>(set))
+                GPIO.out_w1ts = low;
+            if (const auto low = static_cast<std::uint32_t>(clear))
+                GPIO.out_w1tc = low;
+            if (const auto high = static_cast<std::uint32_t>(set >> 32))
+                GPIO.out1_w1ts.data = high;
+            if (const auto high = static_cast<std::uint32_t>(clear >> 32))
+                GPIO.out1_w1tc.data = high;
+        }
+
+        // NOTE: Masks fixed at compile time; registers that aren't touched are dropped entirely, so a bank within GPIO0-31 is a single store
+        template <std::uint64_t SET, std::uint64_t CLEAR = 0>
+        IRAM_ATTR static void write_masks()
+        {
+            static_assert(0 == ((SET | CLEAR) & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK), "Mask selects pins that can't be outputs");
+            static_assert(0 == (SET & CLEAR), "A pin is both set and cleared");
+
+            if constexpr (0 != static_cast<std::uint32_t>(SET))
+                GPIO.out_w1ts = static_cast<std::uint32_t>(SET);
+            if constexpr (0 != static_cast<std::uint32_t>(CLEAR))
+                GPIO.out_w1tc = static_cast<std::uint32_t>(CLEAR);
+            if constexpr (0 != (SET >> 32))
+                GPIO.out1_w1ts.data = static_cast<std::uint32_t>(SET >> 32);
+            if constexpr (0 != (CLEAR >> 32))
+                GPIO.out1_w1tc.data = static_cast<std::uint32_t>(CLEAR >> 32);
+        }
+
+    private:
+        std::uint64_t set_bits{0};
+        std::uint64_t clear_bits{0};
+    };
+
+} // namespace gpio
\ No newline at end of file
@@ -0,0 +1,41 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_DEBUG
+#include "esp_log.h"
+
+#include "pulse.hpp"
+
+#include "esp_timer.h"
+#include "hal/gpio_ll.h"
+
+namespace gpio
+{
+
+    PulseInput::PulseInput(gpio_num_t pin, gpio_pullup_t pull_up, gpio_pulldown_t pull_down) : pin{pin}
+    {
+        assert(GPIO_IS_VALID_GPIO(pin));
+
+        const gpio_config_t config{.pin_bit_mask = 1ULL << pin, .mode = GPIO_MODE_INPUT, .pull_up_en = pull_up, .pull_down_en = pull_down, .intr_type = GPIO_INTR_ANYEDGE};
+        const auto claimed = GpioBase::claim(pin, config);
+        assert(claimed);
+
+        gpio_config(&config);
+
+        ESP_ERROR_CHECK(GpioBase::add_isr_handler(pin, isr, this));
+
+        ESP_LOGI(TAG, "Pulse input on GPIO[%d]", pin);
+    }
+
+    PulseInput::~PulseInput()
+    {
+        GpioBase::remove_isr_handler(pin);
+        GpioBase::wait_for_isrs(); // NOTE: The ISR on the other core may still be using this object
+        gpio_reset_pin(pin);
+        GpioBase::release(pin);
+    }
+
+    IRAM_ATTR void PulseInput::isr(void *arg)
+    {
+        auto &self = *static_cast<PulseInput *>(arg);
+        self.meter.on_edge(esp_timer_get_time(), gpio_ll_get_level(&GPIO, self.pin));
+    }
+
+} // namespace gpio
\ No newline at end of file
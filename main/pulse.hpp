@@ -0,0 +1,127 @@
+#pragma once
+
+#include "gpio.hpp"
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+
+namespace gpio
+{
+
+    static constexpr std::size_t pulse_window{16};      // NOTE: Periods the min/max/mean roll over
+    static constexpr std::int64_t pulse_stale_periods{2}; // NOTE: Periods without an edge after which the input counts as stopped
+
+    struct PulseStats
+    {
+        std::uint32_t edges{0};
+        std::uint32_t periods{0};  // NOTE: Complete rising-to-rising periods seen
+        std::int64_t last_edge_us{0};
+        std::int64_t period_us{0}; // NOTE: Most recent period
+        std::int64_t high_us{0};   // NOTE: Most recent high time
+        std::array<std::uint32_t, pulse_window> window{}; // NOTE: The last pulse_window periods, the oldest overwritten first
+
+        // NOTE: A stopped tachometer or flow meter stops producing edges, so the last period would otherwise be reported forever
+        [[nodiscard]] bool stopped(std::int64_t now_us) const { return period_us <= 0 or now_us - last_edge_us > pulse_stale_periods * period_us; }
+        [[nodiscard]] float frequency_hz(std::int64_t now_us) const { return stopped(now_us) ? 0.0f : 1e6f / period_us; }
+        [[nodiscard]] float duty(std::int64_t now_us) const { return stopped(now_us) ? 0.0f : static_cast<float>(high_us) / period_us; }
+
+        [[nodiscard]] std::size_t window_count() const { return std::min<std::size_t>(periods, pulse_window); }
+        [[nodiscard]] std::int64_t min_period_us() const
+        {
+            const auto periods = std::span{window}.first(window_count());
+            return periods.empty() ? 0 : *std::min_element(periods.begin(), periods.end());
+        }
+        [[nodiscard]] std::int64_t max_period_us() const
+        {
+            const auto periods = std::span{window}.first(window_count());
+            return periods.empty() ? 0 : *std::max_element(periods.begin(), periods.end());
+        }
+        [[nodiscard]] std::int64_t mean_period_us() const
+        {
+            const auto periods = std::span{window}.first(window_count());
+            return periods.empty() ? 0 : std::accumulate(periods.begin(), periods.end(), std::int64_t{0}) / static_cast<std::int64_t>(periods.size());
+        }
+    };
+
+    // NOTE: O(1) per-edge pulse statistics. Written only by the ISR and published through a seqlock, so tasks read snapshots without locking
+    // and the edges themselves never wake a task.
+    class PulseMeter
+    {
+    public:
+        IRAM_ATTR void on_edge(std::int64_t now_us, int level)
+        {
+            const auto seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            ++stats.edges;
+            stats.last_edge_us = now_us;
+
+            if (level)
+            {
+                if (last_rise_us)
+                {
+                    const auto period = now_us - last_rise_us;
+                    stats.period_us = period;
+                    stats.window[stats.periods % pulse_window] = static_cast<std::uint32_t>(std::min<std::int64_t>(period, UINT32_MAX));
+                    ++stats.periods;
+                }
+                last_rise_us = now_us;
+            }
+            else if (last_rise_us)
+                stats.high_us = now_us - last_rise_us;
+
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        [[nodiscard]] PulseStats snapshot() const
+        {
+            while (true)
+            {
+                const auto before = sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+
+                PulseStats ret{stats};
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (before == sequence.load(std::memory_order_relaxed))
+                    return ret;
+            }
+        }
+
+    private:
+        std::atomic<std::uint32_t> sequence{0};
+        PulseStats stats{};
+        std::int64_t last_rise_us{0};
+    };
+
+    // NOTE: Any-edge input feeding a PulseMeter straight from its own ISR; nothing is queued
+    class PulseInput
+    {
+    public:
+        PulseInput(gpio_num_t pin, gpio_pullup_t pull_up = GPIO_PULLUP_DISABLE, gpio_pulldown_t pull_down = GPIO_PULLDOWN_DISABLE);
+        ~PulseInput();
+
+        PulseInput(const PulseInput &) = delete;
+        PulseInput &operator=(const PulseInput &) = delete;
+
+        [[nodiscard]] gpio_num_t get_pin() const { return pin; }
+        [[nodiscard]] PulseStats snapshot() const { return meter.snapshot(); }
+
+    private:
+        static void isr(void *arg);
+
+        gpio_num_t pin;
+        PulseMeter meter{};
+    };
+
+} // namespace gpio
\ No newline at end of file
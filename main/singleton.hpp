@@ -2,11 +2,35 @@
 
 //#include "esp_log.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <utility>
+
+namespace singleton
+{
+
+    struct Heap // NOTE: Instance and control block on the heap, handed out as std::shared_ptr
+    {
+    };
+
+    struct Static // NOTE: Instance constructed in static storage, handed out as an intrusively counted Ref
+    {
+    };
+
+} // namespace singleton
+
+template <class T, class Storage = singleton::Heap>
+class Singleton;
 
 template <class T>
-class Singleton
+class Singleton<T, singleton::Heap>
 {
 public:
     using Shared = std::shared_ptr<T>;
@@ -15,25 +39,30 @@ public:
     template <typename... Args>
     [[nodiscard]] static Shared get_shared(Args &&...args)
     {
+        readers.fetch_add(1);
+        auto shared = published.load() ? instance.lock() : Shared{};
+        readers.fetch_sub(1);
+
+        if (shared) [[likely]]
+            return shared;
+
         std::scoped_lock lock{mutex};
 
         if (instance.expired())
         {
             //ESP_LOGW("Singleton", "Getting shared of %s from a new", T::TAG);
-            auto shared = create(std::forward<Args>(args)...);
-            instance = shared;
+            shared = create(std::forward<Args>(args)...);
+            publish(shared);
             return shared;
         }
         //ESP_LOGW("Singleton", "Getting shared of %s from existing weak", T::TAG);
         return Shared{instance};
     }
 
-    [[nodiscard]] static Weak &get_weak()
+    [[nodiscard]] static Weak get_weak()
     {
-        std::scoped_lock lock{mutex};
-
         //ESP_LOGW("Singleton", "Getting weak of %s", T::TAG);
-        return instance;
+        return read_published();
     }
 
 protected:
@@ -44,12 +73,232 @@ protected:
         return Shared{new T{std::forward<Args>(args)...}};
     }
 
+    // NOTE: Readers announce themselves and then check published; the writer clears published and then waits for readers to drain. Both
+    // sides are seq_cst, so either the reader sees published cleared and falls back to the mutex, or the writer sees the reader and waits.
+    // published stays set after the last Shared is gone, so an expired copy also falls back: a replacement may be being created right now.
+    [[nodiscard]] static Weak read_published()
+    {
+        readers.fetch_add(1);
+
+        if (published.load()) [[likely]]
+        {
+            Weak ret{instance};
+            readers.fetch_sub(1);
+
+            if (not ret.expired()) [[likely]]
+                return ret;
+        }
+        else
+            readers.fetch_sub(1);
+
+        std::scoped_lock lock{mutex};
+        return instance;
+    }
+
+    static void publish(const Shared &shared) // NOTE: Called with the mutex held
+    {
+        published.store(false);
+
+        while (readers.load()) // NOTE: Copying a weak_ptr is a handful of instructions, but the reader may have been preempted
+            vTaskDelay(1);
+
+        instance = shared;
+        published.store(true);
+    }
+
     static Weak instance;
     static std::mutex mutex;
+    static std::atomic<bool> published;
+    static std::atomic<std::uint32_t> readers;
 };
 
 template <class T>
-Singleton<T>::Weak Singleton<T>::instance;
+Singleton<T, singleton::Heap>::Weak Singleton<T, singleton::Heap>::instance;
+
+template <class T>
+std::mutex Singleton<T, singleton::Heap>::mutex;
+
+template <class T>
+std::atomic<bool> Singleton<T, singleton::Heap>::published{false};
+
+template <class T>
+std::atomic<std::uint32_t> Singleton<T, singleton::Heap>::readers{0};
+
+// NOTE: No allocation at all: the instance is placement-constructed in static storage and the count lives beside it, so handing out and
+// copying a reference is a single atomic increment. The instance is still constructed lazily and destroyed when the last Ref goes away.
+template <class T>
+class Singleton<T, singleton::Static>
+{
+public:
+    class Ref
+    {
+    public:
+        constexpr Ref() noexcept = default;
+        constexpr Ref(std::nullptr_t) noexcept {}
+
+        Ref(const Ref &other) noexcept : instance{other.instance}
+        {
+            if (instance)
+                count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Ref(Ref &&other) noexcept : instance{std::exchange(other.instance, nullptr)} {}
+
+        Ref &operator=(Ref other) noexcept
+        {
+            std::swap(instance, other.instance);
+            return *this;
+        }
+
+        ~Ref() { reset(); }
+
+        void reset() noexcept
+        {
+            if (std::exchange(instance, nullptr))
+                release();
+        }
+
+        [[nodiscard]] T *get() const noexcept { return instance; }
+        T *operator->() const noexcept { return instance; }
+        T &operator*() const noexcept { return *instance; }
+        explicit operator bool() const noexcept { return nullptr != instance; }
+
+    private:
+        friend Singleton;
+
+        explicit Ref(T *instance) noexcept : instance{instance} {} // NOTE: Adopts a count already taken
+
+        T *instance{nullptr};
+    };
+
+    // NOTE: Tied to the instance that was current when it was issued, so it never locks a later instance constructed in the same storage
+    class WeakRef
+    {
+    public:
+        constexpr WeakRef() noexcept = default;
+
+        [[nodiscard]] bool expired() const noexcept
+        {
+            return 0 == count.load(std::memory_order_acquire) or issued != generation.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] Ref lock() const noexcept
+        {
+            auto ref = try_acquire();
+            if (ref and issued != generation.load(std::memory_order_acquire)) // NOTE: Can't change while ref holds a count
+                ref.reset();
+            return ref;
+        }
+
+    private:
+        friend Singleton;
+
+        explicit WeakRef(std::uint32_t issued) noexcept : issued{issued} {}
+
+        std::uint32_t issued{0}; // NOTE: Generation 0 never has an instance, so a default WeakRef is always expired
+    };
+
+    using Shared = Ref;
+    using Weak = WeakRef;
+
+    template <typename... Args>
+    [[nodiscard]] static Shared get_shared(Args &&...args)
+    {
+        if (auto shared = try_acquire()) [[likely]]
+            return shared;
+
+        std::scoped_lock lock{mutex};
+
+        if (not alive)
+        {
+            constructor.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+            constructing.store(true); // NOTE: Before the new generation, so get_weak can't see one without the other
+            generation.fetch_add(1);
+
+            ::new (static_cast<void *>(storage())) T{std::forward<Args>(args)...};
+            alive = true;
+
+            count.fetch_add(1, std::memory_order_acq_rel);
+            constructing.store(false);
+            return Ref{instance()};
+        }
+
+        count.fetch_add(1, std::memory_order_acq_rel); // NOTE: Also revives an instance whose last Ref is on its way to release()
+        return Ref{instance()};
+    }
+
+    // NOTE: The count only rises once T's constructor has returned, yet a constructor that starts a driver can have its event handlers call
+    // this before then. Rather than report the instance as gone, wait on the mutex for the constructor to finish. Not while it's being
+    // destroyed: the destructor typically unregisters those same handlers and may wait for them.
+    [[nodiscard]] static Weak get_weak() noexcept
+    {
+        const auto issued = generation.load();
+        if (constructing.load() and constructor.load(std::memory_order_relaxed) != xTaskGetCurrentTaskHandle()) [[unlikely]]
+        {
+            std::scoped_lock lock{mutex};
+            return WeakRef{generation.load()};
+        }
+
+        return WeakRef{issued};
+    }
+
+protected:
+    // NOTE: A function static so sizeof(T) isn't needed while T is still incomplete; zero-initialised, so there's no guard on access
+    [[nodiscard]] static std::byte *storage() noexcept
+    {
+        alignas(T) static std::byte buffer[sizeof(T)];
+        return buffer;
+    }
+
+    [[nodiscard]] static T *instance() noexcept { return std::launder(reinterpret_cast<T *>(storage())); }
+
+    [[nodiscard]] static Ref try_acquire() noexcept
+    {
+        auto current = count.load(std::memory_order_relaxed);
+
+        while (current)
+            if (count.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return Ref{instance()};
+
+        return {};
+    }
+
+    static void release() noexcept
+    {
+        if (1 != count.fetch_sub(1, std::memory_order_acq_rel))
+            return;
+
+        std::scoped_lock lock{mutex};
+
+        if (alive and 0 == count.load(std::memory_order_acquire)) // NOTE: Not revived by get_shared in the meantime
+        {
+            instance()->~T();
+            alive = false;
+        }
+    }
+
+    static std::atomic<std::uint32_t> count;
+    static std::atomic<std::uint32_t> generation; // NOTE: Bumped for every instance constructed
+    static std::atomic<bool> constructing;
+    static std::atomic<TaskHandle_t> constructor; // NOTE: So the constructor itself never waits on get_weak
+    static bool alive;                             // NOTE: Guarded by mutex
+    static std::mutex mutex;
+};
+
+template <class T>
+std::atomic<std::uint32_t> Singleton<T, singleton::Static>::count{0};
+
+template <class T>
+std::atomic<std::uint32_t> Singleton<T, singleton::Static>::generation{0};
+
+template <class T>
+std::atomic<bool> Singleton<T, singleton::Static>::constructing{false};
+
+template <class T>
+std::atomic<TaskHandle_t> Singleton<T, singleton::Static>::constructor{nullptr};
+
+template <class T>
+bool Singleton<T, singleton::Static>::alive{false};
 
 template <class T>
-std::mutex Singleton<T>::mutex;
\ No newline at end of file
+std::mutex Singleton<T, singleton::Static>::mutex;
\ No newline at end of file
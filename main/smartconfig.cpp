@@ -26,7 +26,8 @@ namespace sc
     smartconfig_start_config_t SmartConfig::_config = SMARTCONFIG_START_CONFIG_DEFAULT(); // FIXME ref https://github.com/espressif/esp-idf/pull/12867
     std::unique_ptr<smartconfig_start_config_t> SmartConfig::smartconfigcfg(new smartconfig_start_config_t(_config));
     wifi::Wifi::Shared SmartConfig::wifiobj{nullptr};
-    task::Task SmartConfig::taskhandle{};
+    coro::FlowId SmartConfig::flow{};
+    eventgroup::EventgroupStorage SmartConfig::event_group_storage{};
     eventgroup::Eventgroup SmartConfig::event_group{};
 
     SmartConfig::SmartConfig()
@@ -36,12 +37,12 @@ namespace sc
         if (not wifiobj)
             wifiobj = wifi::Wifi::get_shared();
 
-        event_group = eventgroup::make_eventgroup();
+        event_group = eventgroup::make_eventgroup_static(event_group_storage);
 
         ESP_ERROR_CHECK(esp_event_handler_register(SC_EVENT, ESP_EVENT_ANY_ID, &EventHandlers::event_handler, nullptr));
 
-        assert(not taskhandle);
-        taskhandle = task::make_task(taskfn, TAG, taskstacksize, nullptr, 3);
+        assert(not coro::scheduler().running(flow));
+        flow = coro::scheduler().spawn(done_flow());
 
         ESP_ERROR_CHECK(esp_smartconfig_start(smartconfigcfg.get()));
         state = state_t::STARTED;
@@ -51,7 +52,7 @@ namespace sc
     {
         ESP_LOGD(TAG, "Deconstructing instance");
 
-        taskhandle.reset();
+        coro::scheduler().cancel(flow);
 
         esp_smartconfig_stop();
 
@@ -124,11 +125,11 @@ namespace sc
         return handle_success_t::OK;
     }
 
-    void SmartConfig::taskfn(void *param)
+    coro::Flow SmartConfig::done_flow()
     {
         while (true)
         {
-            const auto bits = eventgroup::wait_bits(event_group, ESPTOUCH_DONE_BIT, true, false);
+            const auto bits = co_await coro::wait_bits(event_group, ESPTOUCH_DONE_BIT, true, false);
 
             if (bits)
             {
@@ -138,10 +139,7 @@ namespace sc
                 ESP_LOGI(TAG, "Done!");
                 esp_smartconfig_stop();
                 state = state_t::DONE;
-
-                task::log_stack(TAG, taskstacksize);
-
-                taskhandle.reset(); // NOTE: This won't return
+                co_return;
             }
         }
     }
@@ -6,6 +6,7 @@
 
 #include "singleton.hpp"
 #include "wifi.hpp"
+#include "wrappers/coroutine.hpp"
 #include "wrappers/eventgroup.hpp"
 #include "wrappers/task.hpp"
 
@@ -23,9 +24,9 @@ namespace sc
 
     static constexpr auto ESPTOUCH_DONE_BIT{BIT1};
 
-    class SmartConfig : public Singleton<SmartConfig> // NOTE: CRTP
+    class SmartConfig : public Singleton<SmartConfig, singleton::Static> // NOTE: CRTP
     {
-        friend Singleton<SmartConfig>; // NOTE: So Singleton can use our private/protected constructor
+        friend Singleton<SmartConfig, singleton::Static>; // NOTE: So Singleton can use our private/protected constructor
 
     public:
         ~SmartConfig();
@@ -65,10 +66,10 @@ namespace sc
             static void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data);
         };
 
-        static task::Task taskhandle;
-        [[noreturn]] static void taskfn(void *param);
-        static constexpr auto taskstacksize = 640 * sizeof(int);
+        static coro::FlowId flow; // NOTE: Runs on the shared coroutine scheduler instead of a task of its own
+        static coro::Flow done_flow();
 
+        static eventgroup::EventgroupStorage event_group_storage;
         static eventgroup::Eventgroup event_group;
     };
 
@@ -17,7 +17,8 @@ namespace wifi
     netif::Netif Wifi::sta_netif;
     std::unique_ptr<wifi_init_config_t> Wifi::wifiinitcfg{new wifi_init_config_t(WIFI_INIT_CONFIG_DEFAULT())};
     nvs::Nvs Wifi::storage{};
-    task::Task Wifi::taskhandle{};
+    coro::FlowId Wifi::flow{};
+    eventgroup::EventgroupStorage Wifi::event_group_storage{};
     eventgroup::Eventgroup Wifi::event_group{};
 
     Wifi::Wifi()
@@ -48,7 +49,7 @@ namespace wifi
         ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
         ESP_ERROR_CHECK(esp_wifi_start());
 
-        event_group = eventgroup::make_eventgroup();
+        event_group = eventgroup::make_eventgroup_static(event_group_storage);
 
         state = state_t::STARTED;
 
@@ -70,7 +71,7 @@ namespace wifi
     {
         ESP_LOGD(TAG, "Deconstructing instance");
 
-        taskhandle.reset();
+        coro::scheduler().cancel(flow);
 
         ESP_LOGD(TAG, "esp_wifi_disconnect");
         esp_wifi_disconnect();
@@ -179,9 +180,9 @@ namespace wifi
         switch (args.event_id)
         {
         case WIFI_EVENT_STA_START:
-            assert(not taskhandle);
-            taskhandle = task::make_task(taskfn, TAG, taskstacksize, nullptr, 3);
-            ESP_LOGI(TAG, "Started task at %p", taskhandle.get());
+            assert(not coro::scheduler().running(flow));
+            flow = coro::scheduler().spawn(connect_flow());
+            ESP_LOGI(TAG, "Started flow %u", flow.index);
             break;
         case WIFI_EVENT_STA_CONNECTED:
             state = state_t::CONNECTED;
@@ -213,23 +214,18 @@ namespace wifi
         return handle_success_t::OK;
     }
 
-    void Wifi::taskfn(void *param)
+    coro::Flow Wifi::connect_flow()
     {
         while (true)
         {
-            // const auto uxBits = xEventGroupWaitBits(event_group.get(), CONNECTED_BIT, true, false, portMAX_DELAY);
-            const auto bits = eventgroup::wait_bits(event_group, CONNECTED_BIT, true, false);
+            const auto bits = co_await coro::wait_bits(event_group, CONNECTED_BIT, true, false);
 
-            // if (uxBits & CONNECTED_BIT)
             if (bits)
             {
                 const auto [ssid, password] = config_to_ssidpasswordview(get_config());
                 ESP_LOGI(TAG, "WiFi Connected to AP %.*s", ssid.size(), ssid.data());
                 state = state_t::DONE;
-
-                task::log_stack(TAG, taskstacksize);
-
-                taskhandle.reset(); // NOTE: This won't return
+                co_return;
             }
         }
     }
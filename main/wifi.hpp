@@ -7,6 +7,7 @@
 #include "freertos/task.h"
 
 #include "singleton.hpp"
+#include "wrappers/coroutine.hpp"
 #include "wrappers/eventgroup.hpp"
 #include "wrappers/netif.hpp"
 #include "wrappers/nvs.hpp"
@@ -35,9 +36,9 @@ namespace wifi
     using SsidPasswordView = std::pair<std::string_view, std::string_view>;
     SsidPasswordView config_to_ssidpasswordview(const wifi_config_t &config);
 
-    class Wifi : public Singleton<Wifi> // NOTE: CRTP
+    class Wifi : public Singleton<Wifi, singleton::Static> // NOTE: CRTP
     {
-        friend Singleton<Wifi>; // NOTE: So Singleton can use our private/protected constructor
+        friend Singleton<Wifi, singleton::Static>; // NOTE: So Singleton can use our private/protected constructor
 
     public:
         ~Wifi();
@@ -91,10 +92,10 @@ namespace wifi
         Wifi(const Wifi &) = delete;
         Wifi &operator=(const Wifi &) = delete;
 
-        static task::Task taskhandle;
-        [[noreturn]] static void taskfn(void *param);
-        static constexpr auto taskstacksize = 640 * sizeof(int);
+        static coro::FlowId flow; // NOTE: Runs on the shared coroutine scheduler instead of a task of its own
+        static coro::Flow connect_flow();
 
+        static eventgroup::EventgroupStorage event_group_storage;
         static eventgroup::Eventgroup event_group;
     };
 
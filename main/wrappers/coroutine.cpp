@@ -0,0 +1,198 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "coroutine.hpp"
+
+#include <algorithm>
+
+namespace coro
+{
+
+    static constexpr const char *const TAG{"Coro"};
+
+    Scheduler::Scheduler(const char *name, uint32_t stacksize, UBaseType_t priority, std::chrono::milliseconds poll_interval)
+        : poll_interval{poll_interval}, reaped{semphr::make_semaphore()}, stopped{semphr::make_semaphore()}
+    {
+        for (auto &slot : slots)
+            slot.watch = claim_watch(wakeup);
+
+        taskhandle = task::make_task(taskfn, name, stacksize, this, priority);
+        assert(taskhandle);
+    }
+
+    Scheduler::~Scheduler()
+    {
+        stopping.store(true);
+        wake();
+        (void)semphr::take(stopped);
+
+        for (auto &slot : slots)
+        {
+            if (slot.handle)
+                reap(slot);
+            if (slot.watch)
+                release_watch(*slot.watch);
+        }
+    }
+
+    FlowId Scheduler::spawn(Flow &&flow)
+    {
+        std::scoped_lock lock{mutex};
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i].handle)
+                continue;
+
+            slots[i].handle = flow.release();
+            wake();
+            return {static_cast<std::uint16_t>(i), slots[i].generation};
+        }
+
+        ESP_LOGE(TAG, "No free slot for a new flow");
+        return {};
+    }
+
+    void Scheduler::cancel(FlowId id)
+    {
+        {
+            std::scoped_lock lock{mutex};
+
+            if (not running(id))
+                return;
+
+            auto &slot = slots[id.index];
+            if (not on_scheduler() and not slot.busy)
+            {
+                reap(slot);
+                return;
+            }
+
+            slot.cancelled = true;
+            if (on_scheduler())
+                return;
+        }
+
+        while (running(id)) // NOTE: The scheduler reaps it once the resume in progress returns
+            (void)semphr::take(reaped, std::chrono::milliseconds{portTICK_PERIOD_MS});
+    }
+
+    bool Scheduler::running(FlowId id)
+    {
+        std::scoped_lock lock{mutex};
+        return id and id.index < slots.size() and slots[id.index].handle and id.generation == slots[id.index].generation;
+    }
+
+    void Scheduler::wake()
+    {
+        notification::give(wakeup);
+    }
+
+    void Scheduler::reap(Slot &slot)
+    {
+        if (slot.watch)
+            disarm(*slot.watch);
+        slot.handle.destroy();
+        slot.handle = {};
+        slot.cancelled = false;
+        ++slot.generation;
+    }
+
+    TickType_t Scheduler::run_pass()
+    {
+        auto sleep = portMAX_DELAY;
+
+        for (auto &slot : slots)
+        {
+            {
+                std::scoped_lock lock{mutex};
+
+                if (not slot.handle)
+                    continue;
+
+                if (slot.cancelled)
+                {
+                    reap(slot);
+                    continue;
+                }
+
+                slot.busy = true;
+            }
+
+            sleep = std::min(sleep, step(slot)); // NOTE: Unlocked, so a flow blocking in user code never stalls spawn() or cancel()
+
+            std::scoped_lock lock{mutex};
+            slot.busy = false;
+
+            if (slot.handle.done() or slot.cancelled)
+            {
+                const auto cancelled = slot.cancelled;
+                reap(slot);
+                if (cancelled)
+                    semphr::give(reaped);
+            }
+        }
+
+        return sleep;
+    }
+
+    TickType_t Scheduler::step(Slot &slot)
+    {
+        auto &promise = slot.handle.promise();
+
+        if (auto wait = promise.waiting) // NOTE: Freshly spawned flows have nothing to wait for
+        {
+            const auto watched = slot.watch and wait->primitive;
+            if (wait->polled and watched)
+                arm(*slot.watch, wait->primitive);
+
+            const auto now = xTaskGetTickCount();
+
+            const auto ready = wait->polled and wait->poll(*wait);
+
+            if (not ready and not wait->expired(now))
+            {
+                auto sleep = portMAX_DELAY;
+                if (wait->polled and not watched)
+                    sleep = task::to_ticks(poll_interval);
+                if (portMAX_DELAY != wait->timeout)
+                    sleep = std::min(sleep, wait->timeout - (now - wait->start));
+                return sleep;
+            }
+
+            if (watched)
+                disarm(*slot.watch);
+            wait->timed_out = not ready;
+        }
+
+        promise.waiting = nullptr;
+        slot.handle.resume();
+        return 0; // NOTE: Take another pass, so the flow's new wait is accounted for
+    }
+
+    void Scheduler::taskfn(void *arg)
+    {
+        auto &self = *static_cast<Scheduler *>(arg);
+
+        while (not self.stopping.load())
+        {
+            const auto sleep = self.run_pass();
+
+            if (0 == sleep)
+                continue;
+
+            const auto wait_for = portMAX_DELAY == sleep ? std::chrono::milliseconds::max() : std::chrono::milliseconds{sleep * portTICK_PERIOD_MS};
+            (void)notification::take(self.wakeup, wait_for);
+        }
+
+        semphr::give(self.stopped);
+        task::delay_forever(); // NOTE: Deleted by taskhandle once the destructor has seen us stop
+    }
+
+    Scheduler &scheduler()
+    {
+        static Scheduler instance{"coro", 3072, 3};
+        return instance;
+    }
+
+} // namespace coro
\ No newline at end of file
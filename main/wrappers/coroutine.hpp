@@ -0,0 +1,242 @@
+#pragma once
+
+#include "eventgroup.hpp"
+#include "notification.hpp"
+#include "semphr.hpp"
+#include "task.hpp"
+#include "watch.hpp"
+
+#include "freertos/FreeRTOS.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+namespace coro
+{
+
+    // NOTE: What a suspended flow is waiting for. The scheduler polls it without blocking and resumes the flow once it's ready or the
+    // timeout has passed. Between polls it sleeps until primitive is signalled; a wait with no primitive is polled every poll_interval.
+    struct Wait
+    {
+        bool (*poll)(Wait &self){nullptr};
+        const void *primitive{nullptr};
+        TickType_t start{0};
+        TickType_t timeout{portMAX_DELAY};
+        bool polled{true}; // NOTE: False for waits only a timeout can end, so the scheduler can sleep until then
+        bool timed_out{false};
+
+        [[nodiscard]] bool expired(TickType_t now) const { return portMAX_DELAY != timeout and now - start >= timeout; }
+    };
+
+    // NOTE: Return type of a coroutine run by a Scheduler. Starts suspended and is owned by the caller until it is spawned.
+    class Flow
+    {
+    public:
+        struct promise_type
+        {
+            Wait *waiting{nullptr};
+
+            Flow get_return_object() { return Flow{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; } // NOTE: The scheduler destroys finished frames
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { abort(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Flow(Flow &&other) noexcept : handle{std::exchange(other.handle, nullptr)} {}
+        Flow &operator=(Flow &&other) noexcept
+        {
+            std::swap(handle, other.handle);
+            return *this;
+        }
+        Flow(const Flow &) = delete;
+        Flow &operator=(const Flow &) = delete;
+
+        ~Flow()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        [[nodiscard]] Handle release() { return std::exchange(handle, nullptr); }
+
+    private:
+        explicit Flow(Handle handle) : handle{handle} {}
+
+        Handle handle;
+    };
+
+    struct FlowId
+    {
+        std::uint16_t index{UINT16_MAX};
+        std::uint16_t generation{0};
+
+        explicit operator bool() const { return UINT16_MAX != index; }
+    };
+
+    // NOTE: Runs any number of flows, up to max_flows, on one FreeRTOS task. Flows only ever suspend on awaitables, which are polled each
+    // pass. The task sleeps until the nearest timeout or until a primitive a flow waits on is signalled (see watch.hpp); only waits with
+    // no primitive to watch bring it back every poll_interval. wake() cuts the sleep short.
+    class Scheduler
+    {
+    public:
+        static constexpr std::size_t max_flows{8};
+
+        Scheduler(const char *name, uint32_t stacksize, UBaseType_t priority, std::chrono::milliseconds poll_interval = std::chrono::milliseconds{10});
+        ~Scheduler(); // NOTE: Destroys any flows that haven't finished
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+
+        // NOTE: Invalid FlowId if every slot is in use
+        [[nodiscard]] FlowId spawn(Flow &&flow);
+
+        // NOTE: From another task this destroys the flow before returning, waiting for it to suspend if it is running. From a flow it takes
+        // effect once the running flow suspends.
+        void cancel(FlowId id);
+
+        [[nodiscard]] bool running(FlowId id);
+
+        void wake();
+
+    private:
+        struct Slot
+        {
+            Flow::Handle handle{};
+            std::uint16_t generation{0};
+            bool cancelled{false};
+            bool busy{false}; // NOTE: Being polled or resumed outside the lock, so only the scheduler may destroy it
+            Watch *watch{nullptr};
+        };
+
+        [[noreturn]] static void taskfn(void *arg);
+
+        [[nodiscard]] TickType_t run_pass();
+        [[nodiscard]] TickType_t step(Slot &slot);
+        void reap(Slot &slot);
+        [[nodiscard]] bool on_scheduler() const { return xTaskGetCurrentTaskHandle() == taskhandle.get(); }
+
+        std::chrono::milliseconds poll_interval;
+        std::array<Slot, max_flows> slots{};
+        std::recursive_mutex mutex{}; // NOTE: Guards the slots, never held while a flow runs; recursive for cancel() calling running()
+        notification::Notification wakeup{};
+        semphr::Semaphore reaped; // NOTE: Given when a cancelled flow is destroyed after its resume, for cancel() from another task
+        std::atomic<bool> stopping{false};
+        semphr::Semaphore stopped;
+        task::Task taskhandle{nullptr};
+    };
+
+    // NOTE: Shared scheduler for the system's small state machines, created on first use
+    [[nodiscard]] Scheduler &scheduler();
+
+    template <class Derived>
+    class Awaiter : public Wait
+    {
+    public:
+        explicit Awaiter(std::chrono::milliseconds timeout)
+        {
+            poll = [](Wait &self) { return static_cast<Derived &>(self).try_now(); };
+            this->timeout = task::to_ticks(timeout);
+        }
+
+        bool await_ready() { return static_cast<Derived &>(*this).try_now(); }
+
+        void await_suspend(Flow::Handle flow)
+        {
+            start = xTaskGetTickCount();
+            flow.promise().waiting = this;
+        }
+    };
+
+    class Delay : public Awaiter<Delay>
+    {
+    public:
+        explicit Delay(std::chrono::milliseconds duration) : Awaiter{duration} { polled = false; }
+
+        bool await_ready() const { return 0 == timeout; }
+        [[nodiscard]] bool try_now() const { return false; } // NOTE: Only the timeout resumes it
+        void await_resume() const {}
+    };
+
+    class WaitBits : public Awaiter<WaitBits>
+    {
+    public:
+        WaitBits(eventgroup::Eventgroup &event_group, eventgroup::Eventbits bits, bool clear_on_exit, bool wait_for_all_bits, std::chrono::milliseconds timeout)
+            : Awaiter{timeout}, event_group{event_group}, bits{bits}, clear_on_exit{clear_on_exit}, wait_for_all_bits{wait_for_all_bits}
+        {
+            primitive = event_group.get();
+        }
+
+        [[nodiscard]] bool try_now()
+        {
+            result = eventgroup::wait_bits(event_group, bits, clear_on_exit, wait_for_all_bits, std::chrono::milliseconds::zero());
+            return result.success;
+        }
+
+        [[nodiscard]] eventgroup::BitsReturn await_resume() const { return result; }
+
+    private:
+        eventgroup::Eventgroup &event_group;
+        eventgroup::Eventbits bits;
+        bool clear_on_exit;
+        bool wait_for_all_bits;
+        eventgroup::BitsReturn result{{}, false};
+    };
+
+    class Take : public Awaiter<Take>
+    {
+    public:
+        Take(semphr::Semaphore &semaphore, std::chrono::milliseconds timeout) : Awaiter{timeout}, semaphore{semaphore} { primitive = semaphore.get(); }
+
+        [[nodiscard]] bool try_now() { return taken = semphr::take(semaphore, std::chrono::milliseconds::zero()); }
+        [[nodiscard]] bool await_resume() const { return taken; }
+
+    private:
+        semphr::Semaphore &semaphore;
+        bool taken{false};
+    };
+
+    template <class Queue>
+    class Pop : public Awaiter<Pop<Queue>>
+    {
+    public:
+        Pop(Queue &queue, std::chrono::milliseconds timeout) : Awaiter<Pop<Queue>>{timeout}, queue{queue} { this->primitive = &queue; }
+
+        [[nodiscard]] bool try_now()
+        {
+            result = queue.pop();
+            return result.success;
+        }
+
+        [[nodiscard]] typename Queue::Ret await_resume() { return std::move(result); }
+
+    private:
+        Queue &queue;
+        typename Queue::Ret result{false};
+    };
+
+    [[nodiscard]] inline Delay delay(std::chrono::milliseconds duration) { return Delay{duration}; }
+
+    [[nodiscard]] inline WaitBits wait_bits(eventgroup::Eventgroup &event_group, eventgroup::Eventbits bits, bool clear_on_exit, bool wait_for_all_bits, std::chrono::milliseconds timeout = std::chrono::milliseconds::max())
+    {
+        return WaitBits{event_group, bits, clear_on_exit, wait_for_all_bits, timeout};
+    }
+
+    [[nodiscard]] inline Take take(semphr::Semaphore &semaphore, std::chrono::milliseconds timeout = std::chrono::milliseconds::max()) { return Take{semaphore, timeout}; }
+
+    template <class Queue>
+    [[nodiscard]] Pop<Queue> pop_wait(Queue &queue, std::chrono::milliseconds timeout = std::chrono::milliseconds::max())
+    {
+        return Pop<Queue>{queue, timeout};
+    }
+
+} // namespace coro
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 #include "eventgroup.hpp"
 #include "task.hpp"
+#include "taskstats.hpp"
+#include "watch.hpp"
+
+#include "freertos/timers.h"
 
 namespace eventgroup
 {
@@ -38,6 +42,11 @@ namespace eventgroup
         return make_eventgroup_from_handle(xEventGroupCreate());
     }
 
+    Eventgroup make_eventgroup_static(EventgroupStorage &storage)
+    {
+        return make_eventgroup_from_handle(xEventGroupCreateStatic(&storage));
+    }
+
     BitsReturn get_bits(const Eventgroup &event_group)
     {
         return {xEventGroupGetBits(event_group.get())};
@@ -67,14 +76,26 @@ namespace eventgroup
 
     BitsReturn set_bits(Eventgroup &event_group, Eventbits bits)
     {
-        return {xEventGroupSetBits(event_group.get(), eventbits2freertos(bits))};
+        const BitsReturn ret{xEventGroupSetBits(event_group.get(), eventbits2freertos(bits))};
+        coro::signal(event_group.get());
+        return ret;
+    }
+
+    static void signal_deferred(void *event_group, uint32_t)
+    {
+        coro::signal(event_group);
     }
 
     BitsReturn set_bits_from_isr(Eventgroup &event_group, Eventbits bits)
     {
         auto before = get_bits_from_isr(event_group);
         BaseType_t higher_priority_task_woken = pdFALSE;
-        auto success = xEventGroupSetBitsFromISR(event_group.get(), eventbits2freertos(bits), &higher_priority_task_woken);
+        const auto success = xEventGroupSetBitsFromISR(event_group.get(), eventbits2freertos(bits), &higher_priority_task_woken);
+
+        // NOTE: The set is deferred to the timer task; queueing the signal behind it means it fires once the bits are set. Only done while
+        // a flow is watching something, since each one takes another slot in the timer queue.
+        if (pdPASS == success and coro::any_armed() and pdPASS != xTimerPendFunctionCallFromISR(signal_deferred, event_group.get(), 0, &higher_priority_task_woken))
+            ESP_DRAM_LOGW("eventgroup", "Timer queue full; a flow waiting on these bits won't be woken until its timeout");
 
         if (pdTRUE == higher_priority_task_woken)
             portYIELD_FROM_ISR();
@@ -86,7 +107,9 @@ namespace eventgroup
     {
         assert(bits.any());
 
-        const Eventbits bitsreceived = xEventGroupWaitBits(event_group.get(), eventbits2freertos(bits), bool2pdTrue(clear_on_exit), bool2pdTrue(wait_for_all_bits), task::to_ticks(wait_time));
+        const auto ticks = task::to_ticks(wait_time);
+        task::BlockTimer timer{task::Primitive::EventGroup, ticks};
+        const Eventbits bitsreceived = xEventGroupWaitBits(event_group.get(), eventbits2freertos(bits), bool2pdTrue(clear_on_exit), bool2pdTrue(wait_for_all_bits), ticks);
 
         const auto masked = bitsreceived & bits;
 
@@ -28,6 +28,10 @@ namespace eventgroup
     [[nodiscard]] Eventgroup make_eventgroup_from_handle(EventGroupHandle_t freertoshandle);
     [[nodiscard]] Eventgroup make_eventgroup();
 
+    using EventgroupStorage = StaticEventGroup_t; // NOTE: Must outlive the event group made from it
+
+    [[nodiscard]] Eventgroup make_eventgroup_static(EventgroupStorage &storage);
+
     using Eventbits = std::bitset<n_event_bits>;
 
     struct BitsReturn
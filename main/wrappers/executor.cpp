@@ -0,0 +1,187 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "executor.hpp"
+
+namespace task
+{
+
+    static constexpr const char *const TAG{"Executor"};
+
+    Executor::Deque::Deque()
+    {
+        for (std::size_t i = 0; i < deque_depth; ++i)
+            spare[i] = static_cast<Node>(i);
+    }
+
+    bool Executor::Deque::push(Job &job)
+    {
+        Node node{0};
+
+        portENTER_CRITICAL(&lock);
+        const auto ok = 0 != spare_count;
+        if (ok)
+            node = spare[--spare_count];
+        portEXIT_CRITICAL(&lock);
+
+        if (not ok)
+            return false;
+
+        nodes[node] = std::move(job);
+
+        portENTER_CRITICAL(&lock);
+        ring[tail++ % deque_depth] = node; // NOTE: Can't overflow, there are only deque_depth nodes
+        portEXIT_CRITICAL(&lock);
+        return true;
+    }
+
+    bool Executor::Deque::pop(Job &job)
+    {
+        Node node{0};
+
+        portENTER_CRITICAL(&lock);
+        const auto ok = tail != head;
+        if (ok)
+            node = ring[--tail % deque_depth];
+        portEXIT_CRITICAL(&lock);
+
+        if (ok)
+            take_node(node, job);
+        return ok;
+    }
+
+    bool Executor::Deque::steal(Job &job)
+    {
+        Node node{0};
+
+        portENTER_CRITICAL(&lock);
+        const auto ok = tail != head;
+        if (ok)
+            node = ring[head++ % deque_depth];
+        portEXIT_CRITICAL(&lock);
+
+        if (ok)
+            take_node(node, job);
+        return ok;
+    }
+
+    void Executor::Deque::take_node(Node node, Job &job)
+    {
+        job = std::move(nodes[node]);
+
+        portENTER_CRITICAL(&lock);
+        spare[spare_count++] = node;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    Executor::Executor(std::size_t workers_per_core, uint32_t stacksize, UBaseType_t priority)
+        : worker_count{workers_per_core * portNUM_PROCESSORS},
+          tokens{semphr::make_counting_semaphore(max_workers * (deque_depth + 1))},
+          stopped{semphr::make_counting_semaphore(max_workers)}
+    {
+        assert(workers_per_core and worker_count <= max_workers);
+
+        // NOTE: Workers are only started once every deque exists, since any of them may steal from the rest
+        for (std::size_t i = 0; i < worker_count; ++i)
+        {
+            workers[i].executor = this;
+            workers[i].index = i;
+        }
+
+        for (std::size_t i = 0; i < worker_count; ++i)
+        {
+            workers[i].handle = make_task_pinned(worker_main, "executor", stacksize, &workers[i], priority, i % portNUM_PROCESSORS);
+            assert(workers[i].handle);
+        }
+
+        ESP_LOGI(TAG, "Started %zu workers over %d cores", worker_count, portNUM_PROCESSORS);
+    }
+
+    Executor::~Executor()
+    {
+        stopping.store(true);
+
+        for (std::size_t i = 0; i < worker_count; ++i)
+            semphr::give(tokens); // NOTE: One extra token each, so every worker wakes once more after the last job and sees stopping
+
+        for (std::size_t i = 0; i < worker_count; ++i)
+            (void)semphr::take(stopped);
+
+        ESP_LOGI(TAG, "Stopped %zu workers", worker_count);
+    }
+
+    Executor::Worker *Executor::current_worker()
+    {
+        const auto self = xTaskGetCurrentTaskHandle();
+
+        for (std::size_t i = 0; i < worker_count; ++i)
+            if (workers[i].handle.get() == self)
+                return &workers[i];
+
+        return nullptr;
+    }
+
+    bool Executor::submit(Job &&job)
+    {
+        assert(job);
+
+        auto first = current_worker() ? current_worker()->index : next_worker.fetch_add(1, std::memory_order_relaxed) % worker_count;
+
+        for (std::size_t i = 0; i < worker_count; ++i)
+        {
+            if (workers[(first + i) % worker_count].deque.push(job))
+            {
+                queued.fetch_add(1);
+                semphr::give(tokens);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Executor::next_job(std::size_t index, Job &job)
+    {
+        auto found = workers[index].deque.pop(job);
+
+        for (std::size_t i = 1; i < worker_count and not found; ++i)
+            found = workers[(index + i) % worker_count].deque.steal(job);
+
+        if (found)
+            queued.fetch_sub(1);
+
+        return found;
+    }
+
+    void Executor::worker_main(void *arg)
+    {
+        auto &worker = *static_cast<Worker *>(arg);
+        auto &executor = *worker.executor;
+
+        while (true)
+        {
+            (void)semphr::take(executor.tokens);
+
+            // NOTE: Tokens are given after the push, so a job exists for every token, but a scan can still miss one that is pushed behind
+            // it while another worker steals ahead of it. A second scan nearly always finds it; past that, sleep a tick rather than spin,
+            // since the worker holding things up may be a preempted one on this core. Only stop once stopping and nothing is queued.
+            Job job{};
+            for (std::size_t misses = 0; not executor.next_job(worker.index, job); ++misses)
+            {
+                if (executor.stopping.load() and 0 == executor.queued.load())
+                    break;
+                if (misses)
+                    vTaskDelay(1);
+            }
+
+            if (not job)
+                break;
+
+            job();
+        }
+
+        semphr::give(executor.stopped);
+        delay_forever(); // NOTE: Deleted by the Task handle once the destructor has seen every worker stop
+    }
+
+} // namespace task
\ No newline at end of file
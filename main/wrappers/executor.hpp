@@ -0,0 +1,182 @@
+#pragma once
+
+#include "semphr.hpp"
+#include "task.hpp"
+
+#include "freertos/FreeRTOS.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace task
+{
+
+    // NOTE: Move-only type-erased void() callable. Captures up to inline_size bytes live inside the Job; bigger ones fall back to the heap,
+    // so capture a pointer to larger state to keep submit allocation-free.
+    class Job
+    {
+    public:
+        static constexpr std::size_t inline_size{32};
+
+        Job() noexcept = default;
+
+        template <class Fn, class Decayed = std::decay_t<Fn>>
+            requires(not std::is_same_v<Decayed, Job> and std::is_invocable_v<Decayed &>)
+        Job(Fn &&fn)
+        {
+            if constexpr (fits<Decayed>)
+            {
+                ::new (static_cast<void *>(storage)) Decayed{std::forward<Fn>(fn)};
+                ops = &inline_ops<Decayed>;
+            }
+            else
+            {
+                *reinterpret_cast<Decayed **>(storage) = new Decayed{std::forward<Fn>(fn)};
+                ops = &heap_ops<Decayed>;
+            }
+        }
+
+        Job(Job &&other) noexcept { take(other); }
+
+        Job &operator=(Job &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                take(other);
+            }
+            return *this;
+        }
+
+        Job(const Job &) = delete;
+        Job &operator=(const Job &) = delete;
+
+        ~Job() { reset(); }
+
+        explicit operator bool() const noexcept { return nullptr != ops; }
+
+        void operator()() { ops->invoke(storage); }
+
+        void reset() noexcept
+        {
+            if (ops)
+                ops->destroy(storage);
+            ops = nullptr;
+        }
+
+    private:
+        struct Ops
+        {
+            void (*invoke)(void *);
+            void (*move)(void *to, void *from); // NOTE: Move constructs into to and destroys from
+            void (*destroy)(void *);
+        };
+
+        template <class Fn>
+        static constexpr bool fits = sizeof(Fn) <= inline_size and alignof(Fn) <= alignof(std::max_align_t) and std::is_nothrow_move_constructible_v<Fn>;
+
+        template <class Fn>
+        static constexpr Ops inline_ops{
+            [](void *self) { (*std::launder(static_cast<Fn *>(self)))(); },
+            [](void *to, void *from)
+            {
+                auto &source = *std::launder(static_cast<Fn *>(from));
+                ::new (to) Fn{std::move(source)};
+                source.~Fn();
+            },
+            [](void *self) { std::launder(static_cast<Fn *>(self))->~Fn(); },
+        };
+
+        template <class Fn>
+        static constexpr Ops heap_ops{
+            [](void *self) { (**static_cast<Fn **>(self))(); },
+            [](void *to, void *from) { *static_cast<Fn **>(to) = *static_cast<Fn **>(from); },
+            [](void *self) { delete *static_cast<Fn **>(self); },
+        };
+
+        void take(Job &other) noexcept
+        {
+            ops = std::exchange(other.ops, nullptr);
+            if (ops)
+                ops->move(storage, other.storage);
+        }
+
+        alignas(std::max_align_t) std::byte storage[inline_size];
+        const Ops *ops{nullptr};
+    };
+
+    // NOTE: Fixed pool of workers pinned to each core. Each worker owns a bounded deque: it pops its own newest job first and, when that's
+    // empty, steals the oldest job from the others. One counting semaphore holds a token per queued job, so idle workers block instead of
+    // spinning, and whoever takes a token is guaranteed a job somewhere in the pool.
+    class Executor
+    {
+    public:
+        static constexpr std::size_t max_workers{2 * portNUM_PROCESSORS};
+        static constexpr std::size_t deque_depth{32};
+
+        explicit Executor(std::size_t workers_per_core = 1, uint32_t stacksize = 3072, UBaseType_t priority = 5);
+        ~Executor(); // NOTE: Runs every job already submitted, including ones submitted by running jobs, then stops the workers
+
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        // NOTE: From a worker the job goes on that worker's own deque, otherwise round-robin; false if every deque is full
+        [[nodiscard]] bool submit(Job &&job);
+
+        [[nodiscard]] std::size_t size() const { return worker_count; }
+
+    private:
+        // NOTE: Jobs sit in fixed nodes and the deque itself only orders node indices, so the spinlock is held just long enough to move an
+        // index. A node belongs to whoever took it off the free list or the ring until it is handed back, and jobs are moved in and out
+        // (and so constructed and destroyed) outside the critical section.
+        struct Deque
+        {
+            using Node = std::uint8_t;
+            static_assert(deque_depth <= 256, "Node indices are a byte");
+
+            portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+            std::array<Job, deque_depth> nodes{};
+            std::array<Node, deque_depth> ring{};
+            std::array<Node, deque_depth> spare{}; // NOTE: Free nodes
+            std::size_t spare_count{deque_depth};
+            std::size_t head{0}; // NOTE: Oldest, stolen from here
+            std::size_t tail{0}; // NOTE: Newest, pushed and popped here by the owner
+
+            Deque();
+
+            [[nodiscard]] bool push(Job &job);
+            [[nodiscard]] bool pop(Job &job);
+            [[nodiscard]] bool steal(Job &job);
+
+        private:
+            void take_node(Node node, Job &job);
+        };
+
+        struct Worker
+        {
+            Executor *executor{nullptr};
+            std::size_t index{0};
+            Task handle{nullptr};
+            Deque deque{};
+        };
+
+        [[noreturn]] static void worker_main(void *arg);
+
+        [[nodiscard]] bool next_job(std::size_t index, Job &job);
+        [[nodiscard]] Worker *current_worker();
+
+        std::array<Worker, max_workers> workers{};
+        std::size_t worker_count{0};
+        std::atomic<std::size_t> next_worker{0};
+        std::atomic<bool> stopping{false};
+        std::atomic<std::size_t> queued{0};
+        semphr::Semaphore tokens;
+        semphr::Semaphore stopped;
+    };
+
+} // namespace task
\ No newline at end of file
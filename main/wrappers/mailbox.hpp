@@ -0,0 +1,174 @@
+#pragma once
+
+#include "esp_system.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "semphr.hpp"
+#include "task.hpp"
+#include "taskstats.hpp"
+
+namespace queue
+{
+
+    // NOTE: Latest-value mailbox holding at most one pending value per key; a new post overwrites the previous one, so the consumer does a
+    // bounded amount of work however fast values arrive. Each key must have a single writer (e.g. one pin's ISR), readers can be anywhere.
+    template <class T, std::size_t Keys = 1>
+    class Mailbox
+    {
+        static_assert(Keys > 0, "Mailbox needs at least one key");
+        static_assert(std::is_trivially_copyable_v<T>, "Mailbox needs a trivially copyable T, latest() may copy it while a writer is mid-store");
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Mailbox needs lock-free 32 bit atomics to be used from an ISR");
+
+        static constexpr std::size_t bits_per_word = 32;
+        static constexpr std::size_t n_words = (Keys + bits_per_word - 1) / bits_per_word;
+
+        struct Slot
+        {
+            std::atomic<std::uint32_t> sequence{0}; // NOTE: Odd while a write is in progress
+            T value{};
+        };
+
+        std::array<Slot, Keys> slots{};
+        std::array<std::atomic<std::uint32_t>, n_words> pending{};
+        semphr::SemaphoreStorage storage{};
+        mutable semphr::Semaphore semaphore{semphr::make_semaphore_static(storage)}; // NOTE: Binary, so a burst of posts is a single wake
+        portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;                              // NOTE: Keeps task-context writes from being preempted
+
+        IRAM_ATTR bool store(std::size_t key, const T &value)
+        {
+            assert(key < Keys);
+
+            auto &slot = slots[key];
+            const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.value = value;
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+
+            const auto bit = std::uint32_t{1} << (key % bits_per_word);
+            const auto before = pending[key / bits_per_word].fetch_or(bit, std::memory_order_release);
+            return not(before & bit); // NOTE: Only wake the consumer if this key wasn't already pending
+        }
+
+    public:
+        [[nodiscard]] static constexpr std::size_t keys() noexcept { return Keys; }
+
+        // NOTE: The write is a critical section, otherwise a higher priority reader on this core could preempt it half way and spin in
+        // latest() forever waiting for a writer that can't run. An ISR writer can't be preempted by a task, so post_from_isr needs none.
+        void post(std::size_t key, const T &value)
+        {
+            portENTER_CRITICAL(&lock);
+            const auto wake = store(key, value);
+            portEXIT_CRITICAL(&lock);
+
+            if (wake)
+                semphr::give(semaphore);
+        }
+
+        IRAM_ATTR void post_from_isr(std::size_t key, const T &value)
+        {
+            if (store(key, value))
+                semphr::give_from_isr(semaphore);
+        }
+
+        void post(const T &value) { post(0, value); }
+        IRAM_ATTR void post_from_isr(const T &value) { post_from_isr(0, value); }
+
+        // NOTE: Consistent copy of the newest value for key, whether or not it is still pending
+        [[nodiscard]] T latest(std::size_t key = 0) const
+        {
+            assert(key < Keys);
+
+            const auto &slot = slots[key];
+            while (true)
+            {
+                const auto before = slot.sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                    continue;
+
+                T value{slot.value};
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (before == slot.sequence.load(std::memory_order_relaxed))
+                    return value;
+            }
+        }
+
+        [[nodiscard]] bool is_pending(std::size_t key = 0) const
+        {
+            assert(key < Keys);
+            return pending[key / bits_per_word].load(std::memory_order_acquire) & (std::uint32_t{1} << (key % bits_per_word));
+        }
+
+        // NOTE: Calls fn(key, value) once for every key posted since the last drain; never blocks
+        template <class F>
+        std::size_t drain(F &&fn)
+        {
+            std::size_t count{0};
+
+            for (std::size_t word = 0; word < n_words; ++word)
+            {
+                auto bits = pending[word].exchange(0, std::memory_order_acquire);
+                while (bits)
+                {
+                    const auto key = word * bits_per_word + __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    fn(key, latest(key));
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        // NOTE: Blocks until something is posted, then drains; returns 0 only on timeout. A wake can be stale, given for keys an earlier
+        // drain already took, so an empty drain goes back to waiting against the same deadline.
+        template <class F>
+        std::size_t drain_wait(F &&fn, std::chrono::milliseconds wait_for = std::chrono::milliseconds::max())
+        {
+            if (auto count = drain(fn))
+            {
+                (void)semphr::take(semaphore, std::chrono::milliseconds::zero()); // NOTE: Drop the wake for what was just drained
+                return count;
+            }
+
+            const auto ticks = task::to_ticks(wait_for);
+            const auto start = xTaskGetTickCount();
+            auto remaining = wait_for;
+
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+            while (semphr::take(semaphore, remaining))
+            {
+                if (auto count = drain(fn))
+                    return count;
+
+                if (portMAX_DELAY == ticks)
+                    continue;
+
+                const auto elapsed = xTaskGetTickCount() - start;
+                if (elapsed >= ticks)
+                    break;
+                remaining = std::chrono::milliseconds{pdTICKS_TO_MS(ticks - elapsed)};
+            }
+
+            return 0;
+        }
+    };
+
+    template <class T, std::size_t Keys = 1>
+    [[nodiscard]] auto make_mailbox()
+    {
+        return std::make_shared<Mailbox<T, Keys>>();
+    }
+
+} // namespace queue
\ No newline at end of file
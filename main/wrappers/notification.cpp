@@ -0,0 +1,79 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "notification.hpp"
+#include "task.hpp"
+#include "taskstats.hpp"
+
+#include <cassert>
+
+namespace notification
+{
+
+    [[nodiscard]] static bool try_take(Notification &notification)
+    {
+        auto count = notification.count.load(std::memory_order_relaxed);
+        while (count > 0)
+            if (notification.count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    bool take(Notification &notification, std::chrono::milliseconds wait_time)
+    {
+        const auto ticks = task::to_ticks(wait_time);
+        const auto start = xTaskGetTickCount();
+        task::BlockTimer timer{task::Primitive::Notification, ticks};
+
+        assert(notification.index < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+        // NOTE: Bound once rather than published per take, so a give never notifies a task that has since returned, or been deleted
+        const auto self = xTaskGetCurrentTaskHandle();
+        TaskHandle_t owner{nullptr};
+        if (not notification.owner.compare_exchange_strong(owner, self, std::memory_order_acq_rel))
+            assert(self == owner);
+
+        bool taken = false;
+        while (not(taken = try_take(notification)))
+        {
+            auto remaining = portMAX_DELAY;
+            if (portMAX_DELAY != ticks)
+            {
+                const auto elapsed = xTaskGetTickCount() - start;
+                if (elapsed >= ticks)
+                    break;
+                remaining = ticks - elapsed;
+            }
+
+            ulTaskNotifyTakeIndexed(notification.index, pdTRUE, remaining); // NOTE: Only a wake-up hint; the count above is the source of truth
+        }
+
+        return taken;
+    }
+
+    bool give(Notification &notification)
+    {
+        notification.count.fetch_add(1, std::memory_order_release);
+
+        if (auto owner = notification.owner.load(std::memory_order_acquire))
+            xTaskNotifyGiveIndexed(owner, notification.index);
+
+        return true;
+    }
+
+    bool give_from_isr(Notification &notification)
+    {
+        notification.count.fetch_add(1, std::memory_order_release);
+
+        if (auto owner = notification.owner.load(std::memory_order_acquire))
+        {
+            BaseType_t higher_priority_task_woken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(owner, notification.index, &higher_priority_task_woken);
+            if (pdTRUE == higher_priority_task_woken)
+                portYIELD_FROM_ISR();
+        }
+
+        return true;
+    }
+
+} // namespace notification
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "esp_system.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace notification
+{
+
+    // NOTE: Reserved for Notification; index 0 belongs to the kernel, IDF and anything using the plain xTaskNotify calls
+    static constexpr UBaseType_t notification_index{1};
+    static_assert(notification_index < configTASK_NOTIFICATION_ARRAY_ENTRIES, "Raise CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES");
+
+    // NOTE: Counting semaphore replacement built on direct-to-task notifications, so no kernel object is created. The first task to take
+    // it becomes its only consumer for good; that task must outlive it, and must not use its notification slot at index for anything else.
+    struct Notification
+    {
+        std::atomic<TaskHandle_t> owner{nullptr};
+        std::atomic<UBaseType_t> count{0};
+        UBaseType_t index{notification_index};
+    };
+
+    [[nodiscard]] bool take(Notification &notification, std::chrono::milliseconds wait_time = std::chrono::milliseconds::max());
+    bool give(Notification &notification);
+    IRAM_ATTR bool give_from_isr(Notification &notification);
+
+} // namespace notification
\ No newline at end of file
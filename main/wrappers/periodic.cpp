@@ -0,0 +1,74 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "periodic.hpp"
+#include "task.hpp"
+
+#include "esp_timer.h"
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdlib>
+
+namespace task
+{
+
+    Periodic::Periodic(std::chrono::milliseconds period) : period{to_ticks(period)}, last_wake{xTaskGetTickCount()}
+    {
+        assert(0 != this->period and portMAX_DELAY != this->period);
+    }
+
+    bool Periodic::wait()
+    {
+        const TickType_t behind = xTaskGetTickCount() - last_wake; // NOTE: Unsigned, so tick count wrap is harmless
+
+        if (behind > period) // NOTE: Exactly one period behind is the release due now, which xTaskDelayUntil returns for straight away
+        {
+            const TickType_t missed = behind / period;
+            last_wake += missed * period; // NOTE: The latest release that has passed, so the phase is kept
+
+            ++statistics.overruns;
+            statistics.skipped += missed - 1;
+            on_release(missed);
+            return false;
+        }
+
+        const auto delayed = pdTRUE == xTaskDelayUntil(&last_wake, period);
+        on_release(1);
+        return delayed;
+    }
+
+    void Periodic::reset()
+    {
+        last_wake = xTaskGetTickCount();
+        last_release_us = 0;
+    }
+
+    void Periodic::on_release(uint32_t periods)
+    {
+        const auto now = esp_timer_get_time();
+
+        if (last_release_us)
+        {
+            const int64_t nominal = static_cast<int64_t>(periods) * period * portTICK_PERIOD_MS * 1000;
+            const auto jitter = now - last_release_us - nominal;
+
+            if (0 == statistics.intervals or jitter < statistics.jitter_min_us)
+                statistics.jitter_min_us = jitter;
+            if (0 == statistics.intervals or jitter > statistics.jitter_max_us)
+                statistics.jitter_max_us = jitter;
+            statistics.jitter_abs_sum_us += std::llabs(jitter);
+            ++statistics.intervals;
+        }
+
+        last_release_us = now;
+        ++statistics.releases;
+    }
+
+    void Periodic::log_stats(const char *tag) const
+    {
+        ESP_LOGI(tag, "period %" PRIu32 " ticks: %" PRIu32 " releases, %" PRIu32 " overruns, %" PRIu32 " skipped, jitter %" PRId64 "/%" PRId64 "/%" PRId64 " us (min/max/mean abs)",
+                 static_cast<uint32_t>(period), statistics.releases, statistics.overruns, statistics.skipped, statistics.jitter_min_us, statistics.jitter_max_us, statistics.jitter_mean_abs_us());
+    }
+
+} // namespace task
\ No newline at end of file
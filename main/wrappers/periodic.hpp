@@ -0,0 +1,54 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace task
+{
+
+    struct PeriodicStats
+    {
+        uint32_t releases{0};
+        uint32_t overruns{0};     // NOTE: Calls to wait() made after the release time had already passed
+        uint32_t skipped{0};      // NOTE: Whole periods dropped to get back in phase after an overrun
+        uint32_t intervals{0};    // NOTE: Release-to-release intervals measured for jitter
+        int64_t jitter_min_us{0}; // NOTE: Measured interval minus the nominal one
+        int64_t jitter_max_us{0};
+        uint64_t jitter_abs_sum_us{0};
+
+        [[nodiscard]] int64_t jitter_mean_abs_us() const { return intervals ? jitter_abs_sum_us / intervals : 0; }
+    };
+
+    // NOTE: Fixed-rate release for a loop owned by one task. The wake reference lives in the object, so any number of loops can run side by side.
+    // Releases stay on the phase set at construction (or reset()); an overrun releases immediately and drops the periods that were missed
+    // entirely instead of bursting through them.
+    class Periodic
+    {
+    public:
+        explicit Periodic(std::chrono::milliseconds period);
+
+        // NOTE: Blocks until the next release; returns false if it was already due, whether or not that counts as an overrun
+        bool wait();
+
+        // NOTE: Re-phases to now, e.g. after the loop was paused
+        void reset();
+
+        [[nodiscard]] TickType_t period_ticks() const { return period; }
+        [[nodiscard]] const PeriodicStats &stats() const { return statistics; }
+        void clear_stats() { statistics = {}; }
+
+        void log_stats(const char *tag) const;
+
+    private:
+        TickType_t period;
+        TickType_t last_wake;
+        int64_t last_release_us{0};
+        PeriodicStats statistics{};
+
+        void on_release(uint32_t periods);
+    };
+
+} // namespace task
\ No newline at end of file
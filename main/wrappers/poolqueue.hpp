@@ -0,0 +1,134 @@
+#pragma once
+
+#include "esp_system.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "queue.hpp"
+
+namespace queue
+{
+
+    // NOTE: Zero-copy queue for large items. Payloads live in a fixed pool and only their slot index goes through the kernel queues; a Buffer
+    // is the ownership handle for one slot and returns it to the pool when destroyed. The PoolQueue must outlive every Buffer taken from it.
+    template <class Payload, std::size_t Count>
+    class PoolQueue
+    {
+        using Index = std::uint16_t;
+        static_assert(Count > 0 and Count <= std::numeric_limits<Index>::max(), "PoolQueue slot count out of range");
+
+        std::array<Payload, Count> slots{};
+        QueueStorage<Index, Count> free_storage{};
+        QueueStorage<Index, Count> ready_storage{};
+        QueueHandle<Index> free_slots{make_queue_static(free_storage)};
+        QueueHandle<Index> ready{make_queue_static(ready_storage)};
+
+        void release(Index index)
+        {
+            const auto success = free_slots.send(index, 0);
+            assert(success); // NOTE: Can't fail; there are exactly Count indices in circulation
+        }
+
+    public:
+        class Buffer
+        {
+            friend PoolQueue;
+
+            PoolQueue *pool{nullptr};
+            Index index{};
+
+            Buffer(PoolQueue *pool, Index index) : pool{pool}, index{index} {}
+
+        public:
+            Buffer() = default;
+            Buffer(const Buffer &) = delete;
+            Buffer &operator=(const Buffer &) = delete;
+            Buffer(Buffer &&other) noexcept : pool{std::exchange(other.pool, nullptr)}, index{other.index} {}
+            Buffer &operator=(Buffer &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    pool = std::exchange(other.pool, nullptr);
+                    index = other.index;
+                }
+                return *this;
+            }
+            ~Buffer() { reset(); }
+
+            [[nodiscard]] Payload *get() const { return pool ? &pool->slots[index] : nullptr; }
+            [[nodiscard]] Payload &operator*() const { return *get(); }
+            [[nodiscard]] Payload *operator->() const { return get(); }
+            explicit operator bool() const { return nullptr != pool; }
+
+            void reset()
+            {
+                if (pool)
+                    std::exchange(pool, nullptr)->release(index);
+            }
+        };
+
+        PoolQueue()
+        {
+            for (std::size_t i = 0; i < Count; ++i)
+                release(static_cast<Index>(i));
+        }
+
+        PoolQueue(const PoolQueue &) = delete;
+        PoolQueue &operator=(const PoolQueue &) = delete;
+
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Count; }
+        [[nodiscard]] std::size_t available() const { return free_slots.size(); }
+        [[nodiscard]] std::size_t size() const { return ready.size(); }
+
+        // NOTE: Producer side; fill the payload in place then hand it to send()
+        [[nodiscard]] Buffer acquire(TickType_t ticks = portMAX_DELAY)
+        {
+            if (const auto slot = free_slots.receive(ticks))
+                return {this, slot.item};
+            return {};
+        }
+
+        // NOTE: Ownership only moves into the queue on success, so the caller still holds the buffer if this times out
+        bool send(Buffer &&buffer, TickType_t ticks = portMAX_DELAY)
+        {
+            assert(this == buffer.pool);
+
+            if (not ready.send(buffer.index, ticks))
+                return false;
+
+            buffer.pool = nullptr;
+            return true;
+        }
+
+        // NOTE: Consumer side; the slot goes back to the pool when the returned buffer is destroyed or reset
+        [[nodiscard]] Buffer receive(TickType_t ticks = portMAX_DELAY)
+        {
+            if (const auto slot = ready.receive(ticks))
+                return {this, slot.item};
+            return {};
+        }
+    };
+
+    template <std::size_t Size, std::size_t Count>
+    using BufferPool = PoolQueue<std::array<std::byte, Size>, Count>;
+
+    template <class Payload, std::size_t Count>
+    using Pool = std::shared_ptr<PoolQueue<Payload, Count>>;
+
+    template <class Payload, std::size_t Count>
+    [[nodiscard]] Pool<Payload, Count> make_poolqueue()
+    {
+        return std::make_shared<PoolQueue<Payload, Count>>();
+    }
+
+} // namespace queue
\ No newline at end of file
@@ -1,22 +1,38 @@
 #pragma once
 
 #include "esp_system.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "queuestats.hpp"
+#include "taskstats.hpp"
 
 namespace queue
 {
 
-    template <class Item>
+    template <class Item, class Stats = DefaultStats>
     struct QueueHandle
     {
         using pointer = QueueHandle_t;
         using element = Item;
 
+        struct Stamped
+        {
+            Item item;
+            std::int64_t enqueued_us;
+        };
+        using Stored = std::conditional_t<Stats::enabled, Stamped, Item>; // NOTE: What actually goes through the kernel queue
+
         std::size_t size() const { return uxQueueMessagesWaiting(freertoshandle); }
         std::size_t spaces() const { return uxQueueSpacesAvailable(freertoshandle); }
         bool empty() const { return 0 == size(); }
@@ -26,6 +42,8 @@ namespace queue
         IRAM_ATTR bool empty_from_isr() const { return xQueueIsQueueEmptyFromISR(freertoshandle); }
         IRAM_ATTR bool full_from_isr() const { return xQueueIsQueueFullFromISR(freertoshandle); }
 
+        Stats &stats() { return statistics; }
+
         struct Success
         {
             bool success;
@@ -41,28 +59,45 @@ namespace queue
         [[nodiscard]] ItemReturn receive(TickType_t ticks = portMAX_DELAY)
         {
             Item item{};
-            return {{pdTRUE == xQueueReceive(freertoshandle, &item, ticks)}, item};
+            const auto success = receive_into(item, ticks);
+            return {{success}, item};
+        }
+
+        // NOTE: Blocks for the first item only, then takes whatever else is already queued without blocking again
+        [[nodiscard]] std::size_t receive_many(std::span<Item> items, TickType_t ticks = portMAX_DELAY)
+        {
+            if (items.empty() or not receive_into(items.front(), ticks))
+                return 0;
+
+            std::size_t count{1};
+            while (count < items.size() and receive_into(items[count], 0))
+                ++count;
+
+            return count;
         }
 
         [[nodiscard]] IRAM_ATTR ItemReturn receive_from_isr()
         {
-            Item item{};
+            Stored stored{};
             BaseType_t higher_priority_task_woken = pdFALSE;
-            Success ret{pdTRUE == xQueueReceiveFromISR(freertoshandle, &item, &higher_priority_task_woken), item};
+            const bool success = pdTRUE == xQueueReceiveFromISR(freertoshandle, &stored, &higher_priority_task_woken);
             if (pdTRUE == higher_priority_task_woken)
                 portYIELD_FROM_ISR();
-            return ret;
+            return {{success}, success ? unstamp(stored) : Item{}};
         }
 
         Success send(Item item, TickType_t ticks = portMAX_DELAY)
         {
-            return {pdTRUE == xQueueSend(freertoshandle, &item, ticks)};
+            auto stored = stamp(item);
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+            return counted(pdTRUE == xQueueSend(freertoshandle, &stored, ticks));
         }
 
         IRAM_ATTR Success send_from_isr(Item &item)
         {
+            auto stored = stamp(item);
             BaseType_t higher_priority_task_woken = pdFALSE;
-            Success ret{pdTRUE == xQueueSendFromISR(freertoshandle, &item, &higher_priority_task_woken)};
+            Success ret{counted(pdTRUE == xQueueSendFromISR(freertoshandle, &stored, &higher_priority_task_woken))};
             if (pdTRUE == higher_priority_task_woken)
                 portYIELD_FROM_ISR();
             return ret;
@@ -70,18 +105,23 @@ namespace queue
 
         Success send_to_back(Item &item, TickType_t ticks = portMAX_DELAY)
         {
-            return {pdTRUE == xQueueSendToBack(freertoshandle, &item, ticks)};
+            auto stored = stamp(item);
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+            return counted(pdTRUE == xQueueSendToBack(freertoshandle, &stored, ticks));
         }
 
         Success send_to_front(Item &item, TickType_t ticks = portMAX_DELAY)
         {
-            return {pdTRUE == xQueueSendToFront(freertoshandle, &item, ticks)};
+            auto stored = stamp(item);
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+            return counted(pdTRUE == xQueueSendToFront(freertoshandle, &stored, ticks));
         }
 
         IRAM_ATTR Success send_to_back_from_isr(Item &item, BaseType_t *pxHigherPriorityTaskWoken = nullptr)
         {
+            auto stored = stamp(item);
             BaseType_t higher_priority_task_woken = pdFALSE;
-            Success ret{pdTRUE == xQueueSendToBackFromISR(freertoshandle, &item, &higher_priority_task_woken)};
+            Success ret{counted(pdTRUE == xQueueSendToBackFromISR(freertoshandle, &stored, &higher_priority_task_woken))};
             if (pdTRUE == higher_priority_task_woken)
                 portYIELD_FROM_ISR();
             return ret;
@@ -89,8 +129,9 @@ namespace queue
 
         IRAM_ATTR Success send_to_front_from_isr(Item &item, BaseType_t *pxHigherPriorityTaskWoken = nullptr)
         {
+            auto stored = stamp(item);
             BaseType_t higher_priority_task_woken = pdFALSE;
-            Success ret{pdTRUE == xQueueSendToFrontFromISR(freertoshandle, &item, &pxHigherPriorityTaskWoken)};
+            Success ret{counted(pdTRUE == xQueueSendToFrontFromISR(freertoshandle, &stored, &higher_priority_task_woken))};
             if (pdTRUE == higher_priority_task_woken)
                 portYIELD_FROM_ISR();
             return ret;
@@ -98,21 +139,23 @@ namespace queue
 
         [[nodiscard]] ItemReturn peek(TickType_t ticks = portMAX_DELAY) const
         {
-            Item item{};
-            return {{pdTRUE == xQueuePeek(freertoshandle, &item, ticks)}, item};
+            Stored stored{};
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+            const bool success = pdTRUE == xQueuePeek(freertoshandle, &stored, ticks);
+            return {{success}, item_of(stored)};
         }
 
         [[nodiscard]] IRAM_ATTR ItemReturn peek_from_isr() const
         {
-            Item item{};
-            BaseType_t higher_priority_task_woken = pdFALSE;
-            Success ret{pdTRUE == xQueuePeekFromISR(freertoshandle, &item, &higher_priority_task_woken), item};
-            if (pdTRUE == higher_priority_task_woken)
-                portYIELD_FROM_ISR();
-            return ret;
+            Stored stored{};
+            const bool success = pdTRUE == xQueuePeekFromISR(freertoshandle, &stored);
+            return {{success}, item_of(stored)};
         }
 
         QueueHandle(QueueHandle_t handle) : freertoshandle{handle} {}
+        QueueHandle(const QueueHandle &) = delete;
+        QueueHandle &operator=(const QueueHandle &) = delete;
+        QueueHandle(QueueHandle &&other) noexcept : freertoshandle{other.freertoshandle} { other.freertoshandle = nullptr; } // NOTE: Counters restart
         ~QueueHandle()
         {
             if (freertoshandle)
@@ -121,15 +164,87 @@ namespace queue
 
     private:
         QueueHandle_t freertoshandle;
+        Stats statistics{};
+
+        [[nodiscard]] IRAM_ATTR static Stored stamp(const Item &item)
+        {
+            if constexpr (Stats::enabled)
+                return {item, esp_timer_get_time()};
+            else
+                return item;
+        }
+
+        [[nodiscard]] IRAM_ATTR static const Item &item_of(const Stored &stored)
+        {
+            if constexpr (Stats::enabled)
+                return stored.item;
+            else
+                return stored;
+        }
+
+        [[nodiscard]] IRAM_ATTR Item unstamp(const Stored &stored)
+        {
+            if constexpr (Stats::enabled)
+            {
+                statistics.on_pop();
+                statistics.on_latency(esp_timer_get_time() - stored.enqueued_us);
+            }
+            return item_of(stored);
+        }
+
+        IRAM_ATTR Success counted(bool success)
+        {
+            if (success)
+                statistics.on_push();
+            else
+                statistics.on_drop();
+            return {success};
+        }
+
+        bool receive_into(Item &item, TickType_t ticks)
+        {
+            task::BlockTimer timer{task::Primitive::Queue, ticks};
+
+            if constexpr (Stats::enabled)
+            {
+                Stored stored{};
+                if (pdTRUE != xQueueReceive(freertoshandle, &stored, ticks))
+                {
+                    if (0 != ticks)
+                        statistics.on_timeout();
+                    return false;
+                }
+                item = unstamp(stored);
+                return true;
+            }
+            else
+                return pdTRUE == xQueueReceive(freertoshandle, &item, ticks);
+        }
     };
 
-    template <class Item>
-    using Queue = std::shared_ptr<QueueHandle<Item>>;
+    template <class Item, class Stats = DefaultStats>
+    using Queue = std::shared_ptr<QueueHandle<Item, Stats>>;
+
+    template <class Item, class Stats = DefaultStats>
+    [[nodiscard]] Queue<Item, Stats> make_queue(size_t nitems)
+    {
+        using Handle = QueueHandle<Item, Stats>;
+        return Queue<Item, Stats>{std::make_shared<Handle>(xQueueCreate(nitems, sizeof(typename Handle::Stored)))};
+    }
+
+    // NOTE: Must outlive the queue made from it
+    template <class Item, std::size_t NItems, class Stats = DefaultStats>
+    struct QueueStorage
+    {
+        StaticQueue_t control{};
+        std::array<std::uint8_t, NItems * sizeof(typename QueueHandle<Item, Stats>::Stored)> buffer{};
+    };
 
-    template <class Item>
-    [[nodiscard]] Queue<Item> make_queue(size_t nitems)
+    template <class Item, std::size_t NItems, class Stats>
+    [[nodiscard]] QueueHandle<Item, Stats> make_queue_static(QueueStorage<Item, NItems, Stats> &storage)
     {
-        return Queue<Item>{std::make_shared<QueueHandle<Item>>(xQueueCreate(nitems, sizeof(Item)))};
+        using Handle = QueueHandle<Item, Stats>;
+        return Handle{xQueueCreateStatic(NItems, sizeof(typename Handle::Stored), storage.buffer.data(), &storage.control)};
     }
 
 } // namespace queue
\ No newline at end of file
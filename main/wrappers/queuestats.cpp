@@ -0,0 +1,85 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "queuestats.hpp"
+
+#include <cstdio>
+#include <mutex>
+
+namespace queue
+{
+
+    static constexpr const char *const TAG{"QueueStats"};
+
+    struct Registry
+    {
+        std::mutex mutex{};
+        Stats *head{nullptr};
+    };
+
+    [[nodiscard]] static Registry &registry()
+    {
+        static Registry instance{}; // NOTE: Function-local so queues constructed during static initialisation can register
+        return instance;
+    }
+
+    Stats::Stats(const char *name) : name{name}
+    {
+        auto &reg = registry();
+        std::scoped_lock _{reg.mutex};
+
+        next = reg.head;
+        if (next)
+            next->prev = this;
+        reg.head = this;
+    }
+
+    Stats::~Stats()
+    {
+        auto &reg = registry();
+        std::scoped_lock _{reg.mutex};
+
+        if (prev)
+            prev->next = next;
+        else
+            reg.head = next;
+
+        if (next)
+            next->prev = prev;
+    }
+
+    Stats::Snapshot Stats::snapshot() const
+    {
+        Snapshot ret{name};
+        ret.pops = pops.load(std::memory_order_relaxed);
+        ret.pushes = pushes.load(std::memory_order_relaxed);
+        ret.depth = ret.pushes - ret.pops;
+        ret.max_depth = max_depth.load(std::memory_order_relaxed);
+        ret.drops = drops.load(std::memory_order_relaxed);
+        ret.timeouts = timeouts.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < n_buckets; ++i)
+            ret.latency_us[i] = latency_us[i].load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    void dump_stats()
+    {
+        auto &reg = registry();
+        std::scoped_lock _{reg.mutex};
+
+        for (auto stats = reg.head; stats; stats = stats->next)
+        {
+            const auto snap = stats->snapshot();
+
+            char histogram[Stats::n_buckets * 12]{};
+            std::size_t used = 0;
+            for (std::size_t i = 0; i < Stats::n_buckets and used < sizeof(histogram); ++i)
+                used += std::snprintf(histogram + used, sizeof(histogram) - used, " %lu", static_cast<unsigned long>(snap.latency_us[i]));
+
+            ESP_LOGI(TAG, "%s@%p depth %lu/%lu pushed %lu popped %lu dropped %lu timeouts %lu latency_log2us[%s ]", snap.name, stats,
+                     static_cast<unsigned long>(snap.depth), static_cast<unsigned long>(snap.max_depth), static_cast<unsigned long>(snap.pushes),
+                     static_cast<unsigned long>(snap.pops), static_cast<unsigned long>(snap.drops), static_cast<unsigned long>(snap.timeouts), histogram);
+        }
+    }
+
+} // namespace queue
\ No newline at end of file
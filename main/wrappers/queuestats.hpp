@@ -0,0 +1,147 @@
+#pragma once
+
+#include "esp_system.h"
+#include "esp_timer.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// NOTE: Define QUEUE_STATS=1 (e.g. with target_compile_definitions) to instrument every queue by default; individual queues can opt in or out
+// by passing queue::Stats or queue::NoStats as their Stats template argument
+#ifndef QUEUE_STATS
+#define QUEUE_STATS 0
+#endif
+
+namespace queue
+{
+
+    struct NoStats
+    {
+        static constexpr bool enabled = false;
+
+        void set_name(const char *) {}
+        IRAM_ATTR void on_push() {}
+        IRAM_ATTR void on_drop() {}
+        IRAM_ATTR void on_pop() {}
+        void on_timeout() {}
+        IRAM_ATTR void on_latency(std::int64_t) {}
+    };
+
+    class Stats
+    {
+    public:
+        static constexpr bool enabled = true;
+        static constexpr std::size_t n_buckets = 16; // NOTE: Bucket i counts latencies below 2^i us, the last bucket everything above
+
+        struct Snapshot
+        {
+            const char *name;
+            std::uint32_t depth;
+            std::uint32_t max_depth;
+            std::uint32_t pushes;
+            std::uint32_t pops;
+            std::uint32_t drops;
+            std::uint32_t timeouts;
+            std::array<std::uint32_t, n_buckets> latency_us;
+        };
+
+        explicit Stats(const char *name = "queue");
+        ~Stats();
+
+        Stats(const Stats &) = delete;
+        Stats &operator=(const Stats &) = delete;
+
+        void set_name(const char *newname) { name = newname; }
+
+        IRAM_ATTR void on_push()
+        {
+            const auto depth = pushes.fetch_add(1, std::memory_order_relaxed) + 1 - pops.load(std::memory_order_relaxed);
+            auto max = max_depth.load(std::memory_order_relaxed);
+            while (depth > max and not max_depth.compare_exchange_weak(max, depth, std::memory_order_relaxed))
+                ;
+        }
+
+        IRAM_ATTR void on_drop() { drops.fetch_add(1, std::memory_order_relaxed); }
+        IRAM_ATTR void on_pop() { pops.fetch_add(1, std::memory_order_relaxed); }
+        void on_timeout() { timeouts.fetch_add(1, std::memory_order_relaxed); }
+
+        IRAM_ATTR void on_latency(std::int64_t us)
+        {
+            if (us < 0)
+                return;
+
+            std::size_t bucket = 0;
+            while (bucket < n_buckets - 1 and us >= (std::int64_t{1} << bucket))
+                ++bucket;
+            latency_us[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        friend void dump_stats();
+
+        const char *name;
+        std::atomic<std::uint32_t> pushes{0};
+        std::atomic<std::uint32_t> pops{0};
+        std::atomic<std::uint32_t> max_depth{0};
+        std::atomic<std::uint32_t> drops{0};
+        std::atomic<std::uint32_t> timeouts{0};
+        std::array<std::atomic<std::uint32_t>, n_buckets> latency_us{};
+
+        Stats *prev{nullptr}; // NOTE: Intrusive links for the registry of live queues
+        Stats *next{nullptr};
+    };
+
+    using DefaultStats = std::conditional_t<QUEUE_STATS != 0, Stats, NoStats>;
+
+    // NOTE: Logs a line per live instrumented queue
+    void dump_stats();
+
+    // NOTE: Enqueue times for a FIFO whose pushes are serialised with each other and whose pops are serialised with each other. Latency samples
+    // are skipped once Depth or more items are queued, since from there the next push is free to overwrite the oldest item's stamp.
+    template <std::size_t Depth>
+    class StampFifo
+    {
+        std::array<std::int64_t, Depth> stamps{};
+        std::atomic<std::uint32_t> pushed{0};
+        std::atomic<std::uint32_t> popped{0};
+
+    public:
+        // NOTE: Only once the item is really in the container, so a failed push can't clobber a queued item's stamp; then commit()
+        IRAM_ATTR void stamp()
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+            stamps[pushed.load(std::memory_order_relaxed) % Depth] = esp_timer_get_time();
+        }
+        IRAM_ATTR void commit() { pushed.fetch_add(1, std::memory_order_release); }
+
+        [[nodiscard]] std::int64_t latency()
+        {
+            const auto index = popped.fetch_add(1, std::memory_order_relaxed);
+            const auto queued = pushed.load(std::memory_order_acquire) - index;
+            if (0 == queued or queued >= Depth)
+                return -1;
+
+            const auto stamp = stamps[index % Depth];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (pushed.load(std::memory_order_relaxed) - index >= Depth)
+                return -1; // NOTE: The producer caught up and restamped the slot while it was read
+
+            return esp_timer_get_time() - stamp;
+        }
+    };
+
+    template <>
+    class StampFifo<0>
+    {
+    public:
+        IRAM_ATTR void stamp() {}
+        IRAM_ATTR void commit() {}
+        [[nodiscard]] std::int64_t latency() { return -1; }
+    };
+
+} // namespace queue
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "esp_attr.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace queue
+{
+
+    // NOTE: Lock-free single-producer/single-consumer ring with the same push/front/pop interface as std::queue so it can be used as the
+    // Container of a SharableQueue. Storage lives inside the object, so it never touches the heap and is safe to push to from an ISR.
+    template <class T, std::size_t Capacity>
+    class RingBuffer
+    {
+        static_assert(Capacity > 1, "RingBuffer needs room for more than one item");
+        static_assert(0 == (Capacity & (Capacity - 1)), "RingBuffer capacity must be a power of two");
+        static_assert(std::atomic<std::size_t>::is_always_lock_free, "RingBuffer indices must be lock-free to be used from an ISR");
+
+        static constexpr std::size_t mask = Capacity - 1;
+
+        std::array<T, Capacity> buffer{};
+        std::atomic<std::size_t> head{0}; // NOTE: Written only by the consumer
+        std::atomic<std::size_t> tail{0}; // NOTE: Written only by the producer
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        [[nodiscard]] static constexpr size_type capacity() noexcept { return Capacity; }
+
+        [[nodiscard]] IRAM_ATTR size_type size() const noexcept { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+        [[nodiscard]] IRAM_ATTR bool empty() const noexcept { return 0 == size(); }
+        [[nodiscard]] IRAM_ATTR bool full() const noexcept { return Capacity == size(); }
+
+        IRAM_ATTR bool push(const T &item) noexcept { return emplace(item); }
+        IRAM_ATTR bool push(T &&item) noexcept { return emplace(std::move(item)); }
+
+        template <class... Args>
+        IRAM_ATTR bool emplace(Args &&...args) noexcept
+        {
+            const auto current = tail.load(std::memory_order_relaxed);
+
+            if (current - head.load(std::memory_order_acquire) == Capacity) [[unlikely]]
+                return false; // NOTE: Full; the item is dropped rather than overwriting one the consumer may be reading
+
+            buffer[current & mask] = T{std::forward<Args>(args)...};
+            tail.store(current + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] T &front() noexcept
+        {
+            return buffer[head.load(std::memory_order_relaxed) & mask];
+        }
+
+        void pop() noexcept
+        {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+
+    template <class Container>
+    inline constexpr bool is_ring_buffer_v{false};
+
+    template <class T, std::size_t Capacity>
+    inline constexpr bool is_ring_buffer_v<RingBuffer<T, Capacity>>{true};
+
+} // namespace queue
\ No newline at end of file
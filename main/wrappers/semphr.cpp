@@ -3,6 +3,8 @@
 
 #include "semphr.hpp"
 #include "task.hpp"
+#include "taskstats.hpp"
+#include "watch.hpp"
 
 namespace semphr
 {
@@ -28,31 +30,48 @@ namespace semphr
         return make_semaphore_from_handle(xSemaphoreCreateBinary());
     }
 
-    Semaphore make_counting_semaphore(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount = 0)
+    Semaphore make_counting_semaphore(UBaseType_t max_count, UBaseType_t initial_count)
     {
-        return make_semaphore_from_handle(xSemaphoreCreateCounting(uxMaxCount, uxInitialCount));
+        return make_semaphore_from_handle(xSemaphoreCreateCounting(max_count, initial_count));
+    }
+
+    Semaphore make_semaphore_static(SemaphoreStorage &storage)
+    {
+        return make_semaphore_from_handle(xSemaphoreCreateBinaryStatic(&storage));
+    }
+
+    Semaphore make_counting_semaphore_static(SemaphoreStorage &storage, UBaseType_t max_count, UBaseType_t initial_count)
+    {
+        return make_semaphore_from_handle(xSemaphoreCreateCountingStatic(max_count, initial_count, &storage));
     }
 
     bool take(Semaphore &semaphore, std::chrono::milliseconds wait_time)
     {
         if (semaphore)
-            return pdTRUE == xSemaphoreTake(semaphore.get(), task::to_ticks(wait_time));
+        {
+            const auto ticks = task::to_ticks(wait_time);
+            task::BlockTimer timer{task::Primitive::Semaphore, ticks};
+            return pdTRUE == xSemaphoreTake(semaphore.get(), ticks);
+        }
         else
             return false;
     }
 
     bool give(Semaphore &semaphore)
     {
-        if (semaphore)
-            return pdTRUE == xSemaphoreGive(semaphore.get());
-        else
+        if (not semaphore or pdTRUE != xSemaphoreGive(semaphore.get()))
             return false;
+
+        coro::signal(semaphore.get());
+        return true;
     }
 
     bool give_from_isr(Semaphore &semaphore)
     {
         BaseType_t higher_priority_task_woken = pdFALSE;
         auto ret = pdTRUE == xSemaphoreGiveFromISR(semaphore.get(), &higher_priority_task_woken);
+        if (ret)
+            coro::signal_from_isr(semaphore.get());
         if (pdTRUE == higher_priority_task_woken)
             portYIELD_FROM_ISR();
         return ret;
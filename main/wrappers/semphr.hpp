@@ -22,7 +22,12 @@ namespace semphr
 
     [[nodiscard]] Semaphore make_semaphore_from_handle(SemaphoreHandle_t freertoshandle);
     [[nodiscard]] Semaphore make_semaphore();
-    [[nodiscard]] Semaphore make_counting_semaphore();
+    [[nodiscard]] Semaphore make_counting_semaphore(UBaseType_t max_count, UBaseType_t initial_count = 0);
+
+    using SemaphoreStorage = StaticSemaphore_t; // NOTE: Must outlive the semaphore made from it
+
+    [[nodiscard]] Semaphore make_semaphore_static(SemaphoreStorage &storage);
+    [[nodiscard]] Semaphore make_counting_semaphore_static(SemaphoreStorage &storage, UBaseType_t max_count, UBaseType_t initial_count = 0);
 
     [[nodiscard]] bool take(Semaphore &semaphore, std::chrono::milliseconds wait_time = std::chrono::milliseconds::max());
     bool give(Semaphore &semaphore);
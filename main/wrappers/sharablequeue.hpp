@@ -7,22 +7,97 @@
 #include "freertos/task.h"
 
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <span>
+#include <type_traits>
+#include <utility>
 
+#include "notification.hpp"
+#include "queuestats.hpp"
+#include "ringbuffer.hpp"
 #include "semphr.hpp"
 #include "task.hpp"
+#include "taskstats.hpp"
+#include "watch.hpp"
 
 namespace queue
 {
 
-    template <class T, class Container = std::queue<T>>
+    struct SemaphoreSignal
+    {
+        semphr::SemaphoreStorage storage{};
+        semphr::Semaphore semaphore{semphr::make_counting_semaphore_static(storage, std::numeric_limits<UBaseType_t>::max())};
+
+        bool take(std::chrono::milliseconds wait_for) { return semphr::take(semaphore, wait_for); }
+        void give() { semphr::give(semaphore); }
+        IRAM_ATTR void give_from_isr() { semphr::give_from_isr(semaphore); }
+    };
+
+    // NOTE: Cheaper than a semaphore but only one task may consume from the queue: the first one to wait on it
+    struct NotificationSignal
+    {
+        notification::Notification notifier{};
+
+        bool take(std::chrono::milliseconds wait_for) { return notification::take(notifier, wait_for); }
+        void give() { notification::give(notifier); }
+        IRAM_ATTR void give_from_isr() { notification::give_from_isr(notifier); }
+    };
+
+    // NOTE: Blocking MPMC queue. Every successful push gives the signal once and every pop takes it once before touching the container, so
+    // the signal count never exceeds the number of queued items and any number of consumers can share the queue. Waiting never holds the lock.
+    template <class T, class Container = std::queue<T>, class Signal = SemaphoreSignal, class Stats = DefaultStats>
     class SharableQueue
     {
         Container queue{};
-        mutable std::recursive_mutex mutex{};
-        mutable semphr::Semaphore semaphore{semphr::make_semaphore()};
+        mutable std::mutex mutex{};
+        mutable Signal signal{};
+        Stats statistics{};
+        StampFifo<Stats::enabled ? 32 : 0> stamps{};
+
+        template <class... Args>
+        IRAM_ATTR bool container_emplace(Args &&...args)
+        {
+            if constexpr (std::is_same_v<bool, decltype(queue.emplace(std::forward<Args>(args)...))>)
+            {
+                if (not queue.emplace(std::forward<Args>(args)...)) // NOTE: Bounded containers report when they are full
+                {
+                    statistics.on_drop();
+                    return false;
+                }
+            }
+            else
+                queue.emplace(std::forward<Args>(args)...);
+
+            stamps.stamp(); // NOTE: Still invisible to consumers, they can't reach the item before the signal is given
+            stamps.commit();
+            statistics.on_push();
+            return true;
+        }
+
+        template <class... Args>
+        bool locked_emplace(Args &&...args)
+        {
+            {
+                std::scoped_lock _{mutex};
+                if (not container_emplace(std::forward<Args>(args)...))
+                    return false;
+            }
+            signal.give(); // NOTE: Outside the lock so the woken consumer doesn't immediately block on it
+            coro::signal(this);
+            return true;
+        }
+
+        T take_front() // NOTE: Caller must hold the lock and have taken the signal for this item
+        {
+            T item{std::move(queue.front())};
+            queue.pop();
+            statistics.on_pop();
+            statistics.on_latency(stamps.latency());
+            return item;
+        }
 
     public:
         struct Ret
@@ -44,82 +119,115 @@ namespace queue
             return queue.size();
         }
 
-        void push(const T &item)
+        Stats &stats() { return statistics; }
+
+        // NOTE: Not available on a RingBuffer, whose single producer is the ISR; a task pushing too would make it a second one
+        bool push(const T &item)
+            requires(not is_ring_buffer_v<Container>)
         {
-            std::scoped_lock _{mutex};
-            queue.push(item);
-            semphr::give(semaphore);
+            return locked_emplace(item);
         }
 
-        void push(T &&item)
+        bool push(T &&item)
+            requires(not is_ring_buffer_v<Container>)
         {
-            std::scoped_lock _{mutex};
-            queue.push(std::move(item));
-            semphr::give(semaphore);
+            return locked_emplace(std::move(item));
         }
 
         template <class... Args>
-        void emplace(Args &&...args)
+            requires(not is_ring_buffer_v<Container>)
+        bool emplace(Args &&...args)
         {
-            std::scoped_lock _{mutex};
-            queue.emplace(std::forward<Args>(args)...);
-            semphr::give(semaphore);
+            return locked_emplace(std::forward<Args>(args)...);
         }
 
-        void push_from_isr(const T &item)
+        // NOTE: Only lock-free when Container is a RingBuffer, and then the ISR is the sole producer
+        IRAM_ATTR bool push_from_isr(const T &item)
         {
-            queue.push(item);
-            semphr::give_from_isr(semaphore);
+            if (not container_emplace(item))
+                return false;
+            signal.give_from_isr();
+            coro::signal_from_isr(this);
+            return true;
         }
 
-        void push_from_isr(T &&item)
+        IRAM_ATTR bool push_from_isr(T &&item)
         {
-            queue.push(std::move(item));
-            semphr::give_from_isr(semaphore);
+            if (not container_emplace(std::move(item)))
+                return false;
+            signal.give_from_isr();
+            coro::signal_from_isr(this);
+            return true;
         }
 
         template <class... Args>
-        void emplace_from_isr(Args &&...args)
+        IRAM_ATTR bool emplace_from_isr(Args &&...args)
         {
-            queue.emplace(std::forward<Args>(args)...);
-            semphr::give_from_isr(semaphore);
+            if (not container_emplace(std::forward<Args>(args)...))
+                return false;
+            signal.give_from_isr();
+            coro::signal_from_isr(this);
+            return true;
         }
 
         [[nodiscard]] Ret pop()
         {
-            std::scoped_lock _{mutex};
+            return pop_wait(std::chrono::milliseconds::zero());
+        }
 
-            if (empty())
+        [[nodiscard]] Ret pop_wait(std::chrono::milliseconds wait_for = std::chrono::milliseconds::max())
+        {
+            task::BlockTimer timer{task::Primitive::Queue, task::to_ticks(wait_for)}; // NOTE: Outermost, so the signal's own wait is charged to the queue
+            if (not signal.take(wait_for)) // NOTE: Claims one item without holding the lock
+            {
+                if (wait_for != std::chrono::milliseconds::zero())
+                    statistics.on_timeout();
                 return {false};
+            }
 
-            Ret ret{true, std::move(queue.front())};
-            queue.pop();
-
-            return ret;
+            std::scoped_lock _{mutex};
+            return {true, take_front()};
         }
 
-        [[nodiscard]] Ret pop_wait(std::chrono::milliseconds wait_for = std::chrono::milliseconds::max())
+        // NOTE: Blocks for the first item only, then drains whatever else is already queued without waking again
+        [[nodiscard]] std::size_t pop_wait_batch(std::span<T> items, std::chrono::milliseconds wait_for = std::chrono::milliseconds::max())
         {
-            std::scoped_lock _{mutex};
+            if (items.empty())
+                return 0;
 
-            if (auto waiting = pop()) // NOTE: Check is there is something already in the queue waiting to be popped
-                return waiting;
+            task::BlockTimer timer{task::Primitive::Queue, task::to_ticks(wait_for)};
+            if (not signal.take(wait_for))
+            {
+                if (wait_for != std::chrono::milliseconds::zero())
+                    statistics.on_timeout();
+                return 0;
+            }
 
-            if (not semphr::take(semaphore, wait_for)) // NOTE: Wait for something to be pushed to the queue
-                return {false};
+            std::scoped_lock _{mutex};
 
-            Ret ret{true, std::move(queue.front())};
+            items.front() = take_front();
 
-            queue.pop();
+            std::size_t count{1};
+            for (; count < items.size() and signal.take(std::chrono::milliseconds::zero()); ++count)
+                items[count] = take_front();
 
-            return ret;
+            return count;
         }
     };
 
-    template <class T, class Container = std::queue<T>>
+    template <class T, class Container = std::queue<T>, class Signal = SemaphoreSignal, class Stats = DefaultStats>
     [[nodiscard]] auto make_sharablequeue()
     {
-        return std::make_shared<SharableQueue<T, Container>>();
+        return std::make_shared<SharableQueue<T, Container, Signal, Stats>>();
+    }
+
+    template <class T, std::size_t Capacity, class Signal = SemaphoreSignal, class Stats = DefaultStats>
+    using RingQueue = SharableQueue<T, RingBuffer<T, Capacity>, Signal, Stats>;
+
+    template <class T, std::size_t Capacity, class Signal = SemaphoreSignal, class Stats = DefaultStats>
+    [[nodiscard]] auto make_ringqueue()
+    {
+        return make_sharablequeue<T, RingBuffer<T, Capacity>, Signal, Stats>();
     }
 
 } // namespace queue
\ No newline at end of file
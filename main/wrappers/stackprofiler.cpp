@@ -0,0 +1,168 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "stackprofiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <span>
+
+namespace task
+{
+
+    static constexpr const char *const TAG{"StackProfiler"};
+
+    static constexpr std::size_t max_system_tasks{48}; // NOTE: Ours plus the ESP-IDF and Wi-Fi tasks; uxTaskGetSystemState fails if short
+
+    static std::array<StackRecord, max_stack_records> records{};
+    static std::mutex records_mutex{}; // NOTE: Serialises tracking and sampling; never held while logging
+
+    void track_stack(TaskHandle_t handle, const char *name, uint32_t size)
+    {
+        std::unique_lock lock{records_mutex};
+
+        // NOTE: Prefer an unused slot, then the first record of a deleted task
+        StackRecord *slot{nullptr};
+        for (auto &record : records)
+        {
+            if (handle == record.handle)
+                record.handle = nullptr; // NOTE: A task that deleted itself, whose TCB the new task now occupies
+
+            if (0 == record.size)
+            {
+                slot = &record;
+                break;
+            }
+            if (not slot and not record.handle)
+                slot = &record;
+        }
+
+        if (not slot)
+        {
+            lock.unlock();
+            ESP_LOGW(TAG, "No room to track %s", name);
+            return;
+        }
+
+        *slot = {handle, {}, size, size, false};
+        std::strncpy(slot->name.data(), name, slot->name.size() - 1);
+    }
+
+    void untrack_stack(TaskHandle_t handle)
+    {
+        std::scoped_lock lock{records_mutex};
+
+        for (auto &record : records)
+        {
+            if (handle != record.handle)
+                continue;
+
+            record.min_free = std::min<uint32_t>(record.min_free, uxTaskGetStackHighWaterMark(handle));
+            record.handle = nullptr;
+        }
+    }
+
+    void sample_stacks()
+    {
+#if configUSE_TRACE_FACILITY
+        // NOTE: Tasks that vTaskDelete(nullptr) themselves never reach the Deleter, so their handles can dangle. Only tasks the kernel
+        // still lists are sampled, using the high-water mark it reports rather than reading the TCB through our handle.
+        static std::array<TaskStatus_t, max_system_tasks> statuses{}; // NOTE: Static; only ever used under records_mutex
+
+        struct Warning
+        {
+            std::array<char, configMAX_TASK_NAME_LEN> name;
+            uint32_t min_free;
+            uint32_t size;
+        };
+        std::array<Warning, max_stack_records> warnings{};
+        std::size_t n_warnings{0};
+
+        {
+            std::scoped_lock lock{records_mutex};
+
+            const auto count = uxTaskGetSystemState(statuses.data(), statuses.size(), nullptr);
+            if (0 == count)
+                return;
+
+            for (auto &record : records)
+            {
+                if (not record.handle)
+                    continue;
+
+                const auto end = statuses.begin() + count;
+                const auto status = std::find_if(statuses.begin(), end, [&](const TaskStatus_t &status)
+                                                 { return record.handle == status.xHandle; });
+                if (end == status)
+                {
+                    record.handle = nullptr; // NOTE: Deleted itself; keep the peak seen so far for the report
+                    continue;
+                }
+
+                record.min_free = std::min<uint32_t>(record.min_free, status->usStackHighWaterMark);
+
+                if (record.min_free < stack_warn_free and not record.warned)
+                {
+                    warnings[n_warnings++] = {record.name, record.min_free, record.size};
+                    record.warned = true;
+                }
+            }
+        }
+
+        for (const auto &warning : std::span{warnings}.first(n_warnings))
+            ESP_LOGW(TAG, "%s is close to overflowing: %lu of %lu bytes free", warning.name.data(), warning.min_free, warning.size);
+#else
+        ESP_LOGW(TAG, "Sampling stacks needs CONFIG_FREERTOS_USE_TRACE_FACILITY");
+#endif
+    }
+
+    uint32_t recommended_stack(const StackRecord &record)
+    {
+        const auto margin = std::max(stack_margin_min, record.peak() * stack_margin_percent / 100);
+        return (record.peak() + margin + stack_round_to - 1) / stack_round_to * stack_round_to;
+    }
+
+    void report_stacks()
+    {
+        int64_t reclaimable{0};
+
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            StackRecord record{};
+            {
+                std::scoped_lock lock{records_mutex}; // NOTE: Copied out one at a time, so the lock is never held across a log line
+                record = records[i];
+            }
+
+            if (0 == record.size)
+                continue;
+
+            const auto recommended = recommended_stack(record);
+            ESP_LOGI(TAG, "%-16s size %5lu peak %5lu free %5lu recommended %5lu%s", record.name.data(), record.size, record.peak(), record.min_free, recommended, record.handle ? "" : " (deleted)");
+
+            reclaimable += static_cast<int64_t>(record.size) - recommended;
+        }
+
+        ESP_LOGI(TAG, "Trimming to the recommended sizes would reclaim %lld bytes", reclaimable);
+    }
+
+    static coro::Flow profile(std::chrono::milliseconds period, uint32_t report_every)
+    {
+        for (uint32_t samples = 1;; ++samples)
+        {
+            sample_stacks();
+
+            if (report_every and 0 == samples % report_every)
+                report_stacks();
+
+            co_await coro::delay(period);
+        }
+    }
+
+    coro::FlowId start_stack_profiler(std::chrono::milliseconds period, uint32_t report_every)
+    {
+        return coro::scheduler().spawn(profile(period, report_every));
+    }
+
+} // namespace task
\ No newline at end of file
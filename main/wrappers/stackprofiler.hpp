@@ -0,0 +1,49 @@
+#pragma once
+
+#include "coroutine.hpp"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace task
+{
+
+    // NOTE: Sizes are in bytes, which is what stack depths and uxTaskGetStackHighWaterMark use on ESP-IDF
+    struct StackRecord
+    {
+        TaskHandle_t handle{nullptr}; // NOTE: Null once the task has been deleted; the peak is kept for the report
+        std::array<char, configMAX_TASK_NAME_LEN> name{};
+        uint32_t size{0};
+        uint32_t min_free{0};
+        bool warned{false};
+
+        [[nodiscard]] uint32_t peak() const { return size - min_free; }
+    };
+
+    static constexpr std::size_t max_stack_records{24};
+    static constexpr uint32_t stack_warn_free{256}; // NOTE: Warn once a task gets this close to overflowing
+    static constexpr uint32_t stack_margin_min{512}; // NOTE: Recommended size is the peak plus the larger of these margins
+    static constexpr uint32_t stack_margin_percent{25};
+    static constexpr uint32_t stack_round_to{256};
+
+    // NOTE: Called by the make_task functions and the task Deleter
+    void track_stack(TaskHandle_t handle, const char *name, uint32_t size);
+    void untrack_stack(TaskHandle_t handle);
+
+    // NOTE: Samples the high-water mark of every tracked task that is still alive and warns when one is near overflow
+    void sample_stacks();
+
+    [[nodiscard]] uint32_t recommended_stack(const StackRecord &record);
+
+    // NOTE: Logs size, peak, minimum free and recommended size per task, plus the total that trimming would reclaim
+    void report_stacks();
+
+    // NOTE: Samples every period on the coroutine scheduler and reports every report_every samples
+    coro::FlowId start_stack_profiler(std::chrono::milliseconds period = std::chrono::milliseconds{1000}, uint32_t report_every = 60);
+
+} // namespace task
\ No newline at end of file
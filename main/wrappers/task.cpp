@@ -3,6 +3,9 @@
 
 #include "task.hpp"
 
+#include "stackprofiler.hpp"
+#include "taskstats.hpp"
+
 namespace task
 {
 
@@ -11,6 +14,8 @@ namespace task
         if (freertoshandle)
         {
             ESP_LOGD("TaskDeleter", "Deleting task");
+            untrack_stack(freertoshandle);
+            untrack_task(freertoshandle);
             vTaskDelete(freertoshandle);
         }
     }
@@ -32,6 +37,37 @@ namespace task
         {
             return nullptr;
         }
+        track_stack(freertoshandle, taskname, taskstacksize);
+        track_task(freertoshandle, taskname);
+        return make_task_from_taskhandle(freertoshandle);
+    }
+
+    Task make_task_pinned(TaskFunction_t fn, const char *taskname, uint32_t taskstacksize, void *args, UBaseType_t taskpriority, BaseType_t core)
+    {
+        TaskHandle_t freertoshandle{nullptr};
+        const auto success = xTaskCreatePinnedToCore(fn, taskname, taskstacksize, args, taskpriority, &freertoshandle, core);
+        ESP_LOGI("Task", "Task %s created on core %d: %s", taskname, core, success ? "success" : "failure");
+
+        if (!success)
+        {
+            return nullptr;
+        }
+        track_stack(freertoshandle, taskname, taskstacksize);
+        track_task(freertoshandle, taskname);
+        return make_task_from_taskhandle(freertoshandle);
+    }
+
+    Task make_task_static(TaskFunction_t fn, const char *taskname, StackType_t *stack, uint32_t taskstacksize, StaticTask_t *tcb, void *args, UBaseType_t taskpriority)
+    {
+        const auto freertoshandle = xTaskCreateStatic(fn, taskname, taskstacksize, args, taskpriority, stack, tcb);
+        ESP_LOGI("Task", "Static task %s created: %s", taskname, freertoshandle ? "success" : "failure");
+
+        if (!freertoshandle)
+        {
+            return nullptr;
+        }
+        track_stack(freertoshandle, taskname, taskstacksize);
+        track_task(freertoshandle, taskname);
         return make_task_from_taskhandle(freertoshandle);
     }
 
@@ -3,7 +3,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 
 namespace task
@@ -20,6 +22,23 @@ namespace task
 
     [[nodiscard]] Task make_task_from_taskhandle(TaskHandle_t freertoshandle);
     [[nodiscard]] Task make_task(TaskFunction_t fn, const char *taskname, uint32_t taskstacksize, void *args, UBaseType_t taskpriority);
+    [[nodiscard]] Task make_task_pinned(TaskFunction_t fn, const char *taskname, uint32_t taskstacksize, void *args, UBaseType_t taskpriority, BaseType_t core);
+
+    // NOTE: Must outlive the task, and may only be reused once the idle task has reaped a task that deleted itself
+    template <std::size_t StackSize>
+    struct TaskStorage
+    {
+        StaticTask_t tcb{};
+        std::array<StackType_t, StackSize> stack{};
+    };
+
+    [[nodiscard]] Task make_task_static(TaskFunction_t fn, const char *taskname, StackType_t *stack, uint32_t taskstacksize, StaticTask_t *tcb, void *args, UBaseType_t taskpriority);
+
+    template <std::size_t StackSize>
+    [[nodiscard]] Task make_task_static(TaskStorage<StackSize> &storage, TaskFunction_t fn, const char *taskname, void *args, UBaseType_t taskpriority)
+    {
+        return make_task_static(fn, taskname, storage.stack.data(), StackSize, &storage.tcb, args, taskpriority);
+    }
 
     void log_stack(const char *tag, uint32_t taskstacksize);
 
@@ -36,10 +55,11 @@ namespace task
         vTaskDelay(to_ticks(ms));
     }
 
-    static inline void delay_until(std::chrono::milliseconds ms)
+    // NOTE: The caller owns last_wake, so every loop keeps its own phase; seed it with xTaskGetTickCount(). Returns false if the release
+    // time had already passed, in which case it doesn't block. task::Periodic builds overrun handling and jitter stats on top of this.
+    static inline bool delay_until(TickType_t &last_wake, std::chrono::milliseconds ms)
     {
-        static auto xLastWakeTime{xTaskGetTickCount()};
-        xTaskDelayUntil(&xLastWakeTime, to_ticks(ms));
+        return pdTRUE == xTaskDelayUntil(&last_wake, to_ticks(ms));
     }
 
     [[noreturn]] static inline void delay_forever()
@@ -0,0 +1,281 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "taskstats.hpp"
+
+#include "esp_freertos_hooks.h"
+#include "esp_timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace task
+{
+
+    static constexpr const char *const TAG{"TaskStats"};
+    static constexpr std::size_t no_record{max_task_stats};
+
+    struct Record
+    {
+        std::atomic<TaskHandle_t> handle{nullptr};
+        portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED; // NOTE: Guards stats against the tick hooks and the owning task
+        TaskStats stats{};
+        uint32_t depth{0}; // NOTE: BlockTimer nesting; only touched by the owning task
+        uint32_t last_runtime_us{0};
+    };
+
+    static std::array<Record, max_task_stats> records{};
+    static std::mutex records_mutex{}; // NOTE: Serialises tracking and sampling; the hot paths only take a record's spinlock
+    static std::array<TaskHandle_t, portNUM_PROCESSORS> last_running{};
+    static int64_t last_sample_us{0};
+
+    [[nodiscard]] IRAM_ATTR static std::size_t find(TaskHandle_t handle)
+    {
+        for (std::size_t i = 0; i < records.size(); ++i)
+            if (handle == records[i].handle.load(std::memory_order_acquire))
+                return i;
+        return no_record;
+    }
+
+    void track_task(TaskHandle_t handle, const char *name)
+    {
+        std::unique_lock lock{records_mutex};
+
+        if (const auto stale = find(handle); no_record != stale)
+            records[stale].handle.store(nullptr, std::memory_order_release); // NOTE: A task that deleted itself, whose TCB the new task now occupies
+
+        const auto index = find(nullptr);
+        if (no_record == index)
+        {
+            lock.unlock();
+            ESP_LOGW(TAG, "No room to track %s", name);
+            return;
+        }
+
+        auto &record = records[index];
+        portENTER_CRITICAL(&record.lock);
+        record.stats = {};
+        record.stats.handle = handle;
+        std::strncpy(record.stats.name.data(), name, record.stats.name.size() - 1);
+        record.depth = 0;
+        record.last_runtime_us = 0;
+        portEXIT_CRITICAL(&record.lock);
+
+        record.handle.store(handle, std::memory_order_release);
+    }
+
+    void untrack_task(TaskHandle_t handle)
+    {
+        std::scoped_lock lock{records_mutex};
+
+        if (const auto index = find(handle); no_record != index)
+            records[index].handle.store(nullptr, std::memory_order_release);
+    }
+
+    BlockTimer::BlockTimer(Primitive primitive, TickType_t ticks) : primitive{primitive}, index{0 == ticks ? no_record : find(xTaskGetCurrentTaskHandle())}
+    {
+        if (no_record == index)
+            return;
+
+        if (0 == records[index].depth++)
+            start = esp_timer_get_time();
+    }
+
+    BlockTimer::~BlockTimer()
+    {
+        if (no_record == index)
+            return;
+
+        auto &record = records[index];
+        if (0 != --record.depth)
+            return;
+
+        const auto elapsed = esp_timer_get_time() - start;
+        const auto slot = static_cast<std::size_t>(primitive);
+
+        portENTER_CRITICAL(&record.lock);
+        record.stats.blocked_us[slot] += elapsed;
+        ++record.stats.waits[slot];
+        portEXIT_CRITICAL(&record.lock);
+    }
+
+    // NOTE: Runs in the tick interrupt of each core
+    IRAM_ATTR static void tick_hook()
+    {
+        const auto core = xPortGetCoreID();
+        const auto running = xTaskGetCurrentTaskHandleForCPU(core);
+
+        const auto switched = running != last_running[core];
+        last_running[core] = running;
+
+        const auto index = find(running);
+        if (no_record == index)
+            return;
+
+        auto &record = records[index];
+        portENTER_CRITICAL_ISR(&record.lock);
+        ++record.stats.core_ticks[core];
+        if (switched)
+            ++record.stats.switches;
+        portEXIT_CRITICAL_ISR(&record.lock);
+    }
+
+    void start_tick_accounting()
+    {
+        static std::once_flag registered;
+        std::call_once(registered, []
+                       {
+                           for (int core = 0; core < portNUM_PROCESSORS; ++core)
+                               ESP_ERROR_CHECK(esp_register_freertos_tick_hook_for_cpu(tick_hook, core)); });
+    }
+
+    void sample_task_stats()
+    {
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+        static std::array<TaskStatus_t, 48> statuses{}; // NOTE: Static; only ever used under records_mutex
+
+        std::scoped_lock lock{records_mutex};
+
+        uint32_t total{0};
+        const auto count = uxTaskGetSystemState(statuses.data(), statuses.size(), &total);
+        if (0 == count)
+            return; // NOTE: More tasks than statuses; sampling a partial list would untrack live tasks
+
+        // NOTE: Tasks that vTaskDelete(nullptr) themselves never reach the Deleter; drop their records before the hooks match a reused TCB
+        for (auto &record : records)
+        {
+            const auto handle = record.handle.load(std::memory_order_acquire);
+            if (handle and std::none_of(statuses.begin(), statuses.begin() + count, [&](const TaskStatus_t &status)
+                                        { return handle == status.xHandle; }))
+                record.handle.store(nullptr, std::memory_order_release);
+        }
+
+        const auto now = esp_timer_get_time();
+        const auto elapsed = now - last_sample_us;
+        last_sample_us = now;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto index = find(statuses[i].xHandle);
+            if (no_record == index)
+                continue;
+
+            auto &record = records[index];
+            const auto runtime = statuses[i].ulRunTimeCounter;
+            const auto delta = runtime - record.last_runtime_us; // NOTE: Unsigned, so a 32 bit counter wrap is harmless
+            record.last_runtime_us = runtime;
+
+            portENTER_CRITICAL(&record.lock);
+            record.stats.runtime_us = runtime;
+            record.stats.cpu_percent = elapsed > 0 ? 100.0f * delta / elapsed : 0.0f;
+            portEXIT_CRITICAL(&record.lock);
+        }
+#else
+        ESP_LOGW(TAG, "CPU %% needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS");
+#endif
+    }
+
+    std::size_t task_stats(std::span<TaskStats> out)
+    {
+        std::scoped_lock lock{records_mutex};
+
+        std::size_t count{0};
+        for (auto &record : records)
+        {
+            if (count == out.size())
+                break;
+            if (not record.handle.load(std::memory_order_acquire))
+                continue;
+
+            portENTER_CRITICAL(&record.lock);
+            out[count++] = record.stats;
+            portEXIT_CRITICAL(&record.lock);
+        }
+        return count;
+    }
+
+    void report_task_stats()
+    {
+        std::array<TaskStats, max_task_stats> stats{};
+        const auto count = task_stats(stats);
+
+        for (const auto &task : std::span{stats}.first(count))
+        {
+            char blocked[96]{};
+            int used{0};
+            for (std::size_t p = 0; p < n_primitives and used < static_cast<int>(sizeof(blocked)); ++p)
+                if (task.waits[p])
+                    used += std::snprintf(blocked + used, sizeof(blocked) - used, " %s %" PRIu32 "/%" PRIu64 "ms", primitive_to_string(static_cast<Primitive>(p)), task.waits[p], task.blocked_us[p] / 1000);
+
+            ESP_LOGI(TAG, "%-16s cpu %5.1f%% core %" PRIu32 "/%" PRIu32 " sw %" PRIu32 "%s", task.name.data(), task.cpu_percent, task.core_ticks[0], task.core_ticks[portNUM_PROCESSORS - 1], task.switches, blocked);
+        }
+    }
+
+    std::string task_stats_json()
+    {
+        std::array<TaskStats, max_task_stats> stats{};
+        const auto count = task_stats(stats);
+
+        std::string json{"{\"tasks\":["};
+        char buffer[96]{};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto &task = stats[i];
+
+            std::snprintf(buffer, sizeof(buffer), "%s{\"name\":\"%s\",\"cpu\":%.2f,\"runtime_us\":%" PRIu32 ",\"core\":[", i ? "," : "", task.name.data(), task.cpu_percent, task.runtime_us);
+            json += buffer;
+            for (std::size_t core = 0; core < task.core_ticks.size(); ++core)
+            {
+                std::snprintf(buffer, sizeof(buffer), "%s%" PRIu32, core ? "," : "", task.core_ticks[core]);
+                json += buffer;
+            }
+
+            std::snprintf(buffer, sizeof(buffer), "],\"switches\":%" PRIu32 ",\"blocked_us\":{", task.switches);
+            json += buffer;
+            for (std::size_t p = 0; p < n_primitives; ++p)
+            {
+                std::snprintf(buffer, sizeof(buffer), "%s\"%s\":%" PRIu64, p ? "," : "", primitive_to_string(static_cast<Primitive>(p)), task.blocked_us[p]);
+                json += buffer;
+            }
+
+            json += "},\"waits\":{";
+            for (std::size_t p = 0; p < n_primitives; ++p)
+            {
+                std::snprintf(buffer, sizeof(buffer), "%s\"%s\":%" PRIu32, p ? "," : "", primitive_to_string(static_cast<Primitive>(p)), task.waits[p]);
+                json += buffer;
+            }
+            json += "}}";
+        }
+
+        json += "]}";
+        return json;
+    }
+
+    static coro::Flow report(std::chrono::milliseconds period, uint32_t json_every)
+    {
+        sample_task_stats(); // NOTE: Sets the baseline, so the first report covers one whole period
+
+        for (uint32_t reports = 1;; ++reports)
+        {
+            co_await coro::delay(period);
+
+            sample_task_stats();
+            report_task_stats();
+
+            if (json_every and 0 == reports % json_every)
+                ESP_LOGI(TAG, "%s", task_stats_json().c_str());
+        }
+    }
+
+    coro::FlowId start_task_stats(std::chrono::milliseconds period, uint32_t json_every)
+    {
+        start_tick_accounting();
+        return coro::scheduler().spawn(report(period, json_every));
+    }
+
+} // namespace task
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "coroutine.hpp"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace task
+{
+
+    enum class Primitive : uint8_t
+    {
+        Queue,
+        Semaphore,
+        EventGroup,
+        Notification,
+        Count,
+    };
+
+    static constexpr std::size_t n_primitives{static_cast<std::size_t>(Primitive::Count)};
+    static constexpr std::size_t max_task_stats{24};
+
+    [[nodiscard, gnu::const]] static constexpr const char *primitive_to_string(Primitive primitive)
+    {
+        switch (primitive)
+        {
+        case Primitive::Queue:
+            return "queue";
+        case Primitive::Semaphore:
+            return "semphr";
+        case Primitive::EventGroup:
+            return "eventgroup";
+        case Primitive::Notification:
+            return "notify";
+        [[unlikely]] default:
+            return "unknown";
+        }
+    }
+
+    struct TaskStats
+    {
+        TaskHandle_t handle{nullptr};
+        std::array<char, configMAX_TASK_NAME_LEN> name{};
+        uint32_t runtime_us{0};                                // NOTE: FreeRTOS run-time counter, esp_timer based
+        float cpu_percent{0.0f};                               // NOTE: Share of one core over the last sample period
+        std::array<uint32_t, portNUM_PROCESSORS> core_ticks{}; // NOTE: Ticks at which the task was found running on each core
+        uint32_t switches{0};                                  // NOTE: Switch-ins seen at tick boundaries, so a lower bound
+        std::array<uint64_t, n_primitives> blocked_us{};
+        std::array<uint32_t, n_primitives> waits{};            // NOTE: Calls that were allowed to block
+    };
+
+    // NOTE: Called by the make_task functions and the task Deleter; a task that blocks before its creator returns misses those first waits
+    void track_task(TaskHandle_t handle, const char *name);
+    void untrack_task(TaskHandle_t handle);
+
+    // NOTE: Charges the time until destruction to the calling task as blocked on primitive. Zero-tick calls can't block, so they aren't
+    // timed, and only the outermost timer counts, so a queue built on a semaphore is reported as a queue.
+    class BlockTimer
+    {
+    public:
+        BlockTimer(Primitive primitive, TickType_t ticks);
+        ~BlockTimer();
+
+        BlockTimer(const BlockTimer &) = delete;
+        BlockTimer &operator=(const BlockTimer &) = delete;
+
+    private:
+        Primitive primitive;
+        std::size_t index;
+        int64_t start{0};
+    };
+
+    // NOTE: Registers the per-core tick hooks that measure core residency; safe to call more than once
+    void start_tick_accounting();
+
+    // NOTE: Pulls the run-time counters and works out CPU % since the previous call
+    void sample_task_stats();
+
+    [[nodiscard]] std::size_t task_stats(std::span<TaskStats> out);
+
+    // NOTE: One line per task
+    void report_task_stats();
+
+    // NOTE: {"tasks":[{"name":...,"cpu":...,"core":[...],"switches":...,"blocked_us":{...},"waits":{...}},...]}
+    [[nodiscard]] std::string task_stats_json();
+
+    // NOTE: Samples and reports every period on the coroutine scheduler, logging the JSON dump every json_every reports
+    coro::FlowId start_task_stats(std::chrono::milliseconds period = std::chrono::milliseconds{10'000}, uint32_t json_every = 6);
+
+} // namespace task
\ No newline at end of file
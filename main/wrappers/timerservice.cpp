@@ -0,0 +1,108 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "timerservice.hpp"
+
+namespace timer
+{
+
+    static constexpr const char *const TAG{"TimerService"};
+    static constexpr int64_t tick_us{1000};
+
+    Service::Service(const char *name) : epoch_us{esp_timer_get_time()}
+    {
+        const esp_timer_create_args_t args{.callback = on_alarm, .arg = this, .dispatch_method = ESP_TIMER_TASK, .name = name, .skip_unhandled_events = true};
+        ESP_ERROR_CHECK(esp_timer_create(&args, &alarm));
+    }
+
+    Service::~Service()
+    {
+        esp_timer_stop(alarm);
+        esp_timer_delete(alarm);
+    }
+
+    std::uint32_t Service::now() const
+    {
+        return static_cast<std::uint32_t>((esp_timer_get_time() - epoch_us) / tick_us);
+    }
+
+    void Service::schedule(Timer &timer, std::chrono::milliseconds delay)
+    {
+        std::scoped_lock lock{mutex};
+
+        if (wheel.empty())
+            (void)wheel.advance(now(), due); // NOTE: Nothing can come due; just keeps an idle wheel's clock close to ours
+
+        wheel.schedule(timer, now() + static_cast<std::uint32_t>(delay.count()) + 1); // NOTE: +1 as now() is part way through a tick
+
+        if (not armed or static_cast<std::int32_t>(timer.deadline - armed_tick) < 0)
+            rearm();
+    }
+
+    bool Service::cancel(Timer &timer)
+    {
+        std::scoped_lock lock{mutex};
+        return wheel.cancel(timer); // NOTE: The alarm is left armed; an early wake just finds nothing due
+    }
+
+    void Service::rearm()
+    {
+        std::uint32_t tick{0};
+        if (not wheel.next_tick(tick))
+        {
+            if (armed)
+                esp_timer_stop(alarm);
+            armed = false;
+            return;
+        }
+
+        if (armed and tick == armed_tick)
+            return;
+
+        if (armed)
+            esp_timer_stop(alarm);
+
+        const auto time = esp_timer_get_time();
+        const auto elapsed = (time - epoch_us) / tick_us;
+        const auto ticks = static_cast<std::int32_t>(tick - static_cast<std::uint32_t>(elapsed)); // NOTE: Tick counts wrap, time doesn't
+        const auto wait_us = epoch_us + (elapsed + ticks) * tick_us - time;
+
+        ESP_ERROR_CHECK(esp_timer_start_once(alarm, wait_us > 0 ? wait_us : 1));
+        armed_tick = tick;
+        armed = true;
+    }
+
+    void Service::on_alarm(void *arg)
+    {
+        auto &self = *static_cast<Service *>(arg);
+
+        {
+            std::scoped_lock lock{self.mutex};
+            self.armed = false;
+            self.wheel.advance(self.now(), self.due);
+            self.rearm();
+        }
+
+        while (true) // NOTE: One timer at a time under the lock, so a cancel from another task still wins until its callback starts
+        {
+            Timer *timer{nullptr};
+            {
+                std::scoped_lock lock{self.mutex};
+                timer = self.due.pop_front();
+            }
+
+            if (not timer)
+                break;
+
+            if (timer->callback)
+                timer->callback(*timer);
+        }
+    }
+
+    Service &service()
+    {
+        static Service instance{};
+        return instance;
+    }
+
+} // namespace timer
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "timerwheel.hpp"
+
+#include "esp_timer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace timer
+{
+
+    // NOTE: One esp_timer drives a Wheel at millisecond resolution instead of each wait holding its own kernel timeout. The alarm is only
+    // ever armed for the wheel's next tick with work, and everything due by then is dispatched as one batch from the esp_timer task, so
+    // callbacks must be short and must not block. They may schedule or cancel timers, including their own.
+    class Service
+    {
+    public:
+        explicit Service(const char *name = "timerwheel");
+        ~Service();
+
+        Service(const Service &) = delete;
+        Service &operator=(const Service &) = delete;
+
+        // NOTE: Reschedules if already pending; the timer fires no earlier than delay from now
+        void schedule(Timer &timer, std::chrono::milliseconds delay);
+
+        // NOTE: Once this returns the callback won't start, though it may already be running
+        bool cancel(Timer &timer);
+
+        [[nodiscard]] std::uint32_t now() const; // NOTE: Milliseconds since construction, wrapping
+
+    private:
+        Wheel<> wheel{};
+        List due{};
+        std::mutex mutex{};
+        esp_timer_handle_t alarm{nullptr};
+        int64_t epoch_us{0};
+        std::uint32_t armed_tick{0};
+        bool armed{false};
+
+        static void on_alarm(void *arg);
+        void rearm(); // NOTE: Called with mutex held
+    };
+
+    // NOTE: The instance shared by the firmware, created on first use
+    Service &service();
+
+} // namespace timer
\ No newline at end of file
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// NOTE: Plain C++ with no ESP-IDF dependencies so it also builds on the host; timer::Service in timerservice.hpp drives it on the target
+
+namespace timer
+{
+
+    struct Link
+    {
+        Link *prev{nullptr};
+        Link *next{nullptr};
+    };
+
+    // NOTE: Intrusive, so scheduling never allocates. Owned by the caller and must stay put while pending.
+    struct Timer : Link
+    {
+        using Callback = void (*)(Timer &timer);
+
+        Callback callback{nullptr};
+        void *arg{nullptr};
+        std::uint32_t deadline{0}; // NOTE: In wheel ticks; compared modulo 2^32 so the tick count may wrap
+
+        [[nodiscard]] bool pending() const { return nullptr != next; }
+    };
+
+    // NOTE: Circular list threaded through the timers' own links; the wheel's slots and the batches of expired timers are both made of these
+    class List
+    {
+    public:
+        List() { clear(); }
+        List(const List &) = delete;
+        List &operator=(const List &) = delete;
+
+        [[nodiscard]] bool empty() const { return head.next == &head; }
+
+        void push_back(Timer &timer)
+        {
+            timer.prev = head.prev;
+            timer.next = &head;
+            head.prev->next = &timer;
+            head.prev = &timer;
+        }
+
+        [[nodiscard]] Timer *pop_front()
+        {
+            if (empty())
+                return nullptr;
+
+            auto &timer = *static_cast<Timer *>(head.next);
+            unlink(timer);
+            return &timer;
+        }
+
+        // NOTE: Moves every timer onto other in O(1)
+        void splice_to(List &other)
+        {
+            if (empty())
+                return;
+
+            head.next->prev = other.head.prev;
+            other.head.prev->next = head.next;
+            head.prev->next = &other.head;
+            other.head.prev = head.prev;
+            clear();
+        }
+
+        // NOTE: Leaves timer unlinked; returns the list's head if that emptied it, so the owner can keep an occupancy map
+        static const Link *unlink(Timer &timer)
+        {
+            timer.prev->next = timer.next;
+            timer.next->prev = timer.prev;
+
+            const Link *neighbour = timer.prev == timer.next ? timer.prev : nullptr;
+            timer.prev = timer.next = nullptr;
+            return neighbour;
+        }
+
+    private:
+        Link head{};
+
+        void clear() { head.prev = head.next = &head; }
+    };
+
+    // NOTE: Hierarchical timing wheel: Levels rings of 64 slots, each level 64 times coarser than the one below.
+    // schedule() and cancel() are O(1); advance() visits only ticks where a slot is occupied, using a bitmap per level, and cascades a
+    // coarse slot into the finer levels when its turn comes. Deadlines further out than the wheel spans are parked in the top level and
+    // re-placed until they are in range. Not thread-safe; the owner serialises access.
+    template <std::size_t Levels = 4>
+    class Wheel
+    {
+        static constexpr std::size_t SlotBits{6}; // NOTE: One 64 bit occupancy map per level
+        static constexpr std::size_t slots_per_level{std::size_t{1} << SlotBits};
+        static constexpr std::uint32_t slot_mask{slots_per_level - 1};
+
+        static_assert(Levels > 0 and Levels * SlotBits < 32, "The wheel must span less than half the 32 bit tick range");
+
+    public:
+        static constexpr std::uint32_t span = (std::uint32_t{1} << (Levels * SlotBits)) - 1; // NOTE: Largest delay placed directly
+
+        explicit Wheel(std::uint32_t now = 0) : current{now} {}
+        Wheel(const Wheel &) = delete;
+        Wheel &operator=(const Wheel &) = delete;
+
+        [[nodiscard]] std::uint32_t now() const { return current; }
+        [[nodiscard]] bool empty() const
+        {
+            for (const auto bits : occupied)
+                if (bits)
+                    return false;
+            return true;
+        }
+
+        // NOTE: Reschedules if the timer is already pending; a deadline that isn't in the future fires on the next tick
+        void schedule(Timer &timer, std::uint32_t deadline)
+        {
+            if (timer.pending())
+                cancel(timer);
+
+            if (static_cast<std::int32_t>(deadline - current) <= 0)
+                deadline = current + 1;
+
+            timer.deadline = deadline;
+            place(timer);
+        }
+
+        void schedule_in(Timer &timer, std::uint32_t ticks) { schedule(timer, current + ticks); }
+
+        // NOTE: Works whether the timer is in the wheel or waiting in a batch handed out by advance(); false if it wasn't pending
+        bool cancel(Timer &timer)
+        {
+            if (not timer.pending())
+                return false;
+
+            if (const auto head = List::unlink(timer))
+                release(head);
+            return true;
+        }
+
+        // NOTE: The next tick that has work, either an expiry or a cascade; false if the wheel is empty
+        [[nodiscard]] bool next_tick(std::uint32_t &tick) const
+        {
+            auto best = std::numeric_limits<std::uint32_t>::max();
+            auto found = false;
+
+            for (std::size_t level = 0; level < Levels; ++level)
+            {
+                if (not occupied[level])
+                    continue;
+
+                const auto shift = level * SlotBits;
+                const std::uint32_t block = (current >> shift) + 1; // NOTE: First block boundary at this level after now
+                const auto skip = std::countr_zero(std::rotr(occupied[level], static_cast<int>(block & slot_mask))); // NOTE: Slots to the next occupied one
+                const std::uint32_t distance = ((block + skip) << shift) - current;
+
+                if (distance < best)
+                    best = distance;
+                found = true;
+            }
+
+            tick = current + best;
+            return found;
+        }
+
+        // NOTE: Moves time forward to now, appending every timer that came due to expired in deadline order; returns how many
+        std::size_t advance(std::uint32_t now, List &expired)
+        {
+            std::size_t count{0};
+
+            while (static_cast<std::int32_t>(now - current) > 0)
+            {
+                std::uint32_t tick{0};
+                if (not next_tick(tick) or static_cast<std::int32_t>(tick - now) > 0)
+                {
+                    current = now;
+                    break;
+                }
+
+                current = tick;
+
+                for (auto level = Levels - 1; level > 0; --level) // NOTE: Coarsest first, since each cascade can feed the one below
+                    if (0 == (tick & ((std::uint32_t{1} << (level * SlotBits)) - 1)))
+                        cascade(level);
+
+                List due{};
+                take_slot(0, tick & slot_mask, due);
+
+                while (auto timer = due.pop_front())
+                {
+                    if (timer->deadline == tick)
+                    {
+                        expired.push_back(*timer);
+                        ++count;
+                    }
+                    else
+                        place(*timer); // NOTE: Was parked beyond the span
+                }
+            }
+
+            return count;
+        }
+
+    private:
+        std::array<List, Levels * slots_per_level> wheel{};
+        std::array<std::uint64_t, Levels> occupied{};
+        std::uint32_t current;
+
+        void place(Timer &timer)
+        {
+            auto delta = timer.deadline - current;
+            if (delta > span)
+                delta = span;
+
+            const auto level = delta ? (std::bit_width(delta) - 1) / SlotBits : 0;
+            const auto slot = ((current + delta) >> (level * SlotBits)) & slot_mask;
+
+            wheel[level * slots_per_level + slot].push_back(timer);
+            occupied[level] |= std::uint64_t{1} << slot;
+        }
+
+        void release(const Link *head)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(head);
+            const auto begin = reinterpret_cast<std::uintptr_t>(wheel.data());
+            if (address < begin or address >= begin + sizeof(wheel))
+                return; // NOTE: A batch list, not one of ours
+
+            const auto index = (address - begin) / sizeof(List); // NOTE: A List is nothing but its head
+            occupied[index / slots_per_level] &= ~(std::uint64_t{1} << (index % slots_per_level));
+        }
+
+        void take_slot(std::size_t level, std::uint32_t slot, List &out)
+        {
+            wheel[level * slots_per_level + slot].splice_to(out);
+            occupied[level] &= ~(std::uint64_t{1} << slot);
+        }
+
+        void cascade(std::size_t level)
+        {
+            List moving{};
+            take_slot(level, (current >> (level * SlotBits)) & slot_mask, moving);
+
+            while (auto timer = moving.pop_front())
+                place(*timer);
+        }
+    };
+
+} // namespace timer
\ No newline at end of file
@@ -0,0 +1,81 @@
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+
+#include "watch.hpp"
+
+#include <array>
+
+namespace coro
+{
+
+    DRAM_ATTR static std::array<Watch, max_watches> watches{};
+    DRAM_ATTR static std::atomic<std::uint32_t> armed{0};
+
+    Watch *claim_watch(notification::Notification &waker)
+    {
+        for (auto &watch : watches)
+        {
+            notification::Notification *expected{nullptr};
+            if (watch.waker.compare_exchange_strong(expected, &waker))
+                return &watch;
+        }
+
+        ESP_LOGW("Watch", "No free watch; a flow will be polled instead");
+        return nullptr;
+    }
+
+    void release_watch(Watch &watch)
+    {
+        disarm(watch);
+        watch.waker.store(nullptr);
+    }
+
+    void arm(Watch &watch, const void *primitive)
+    {
+        if (nullptr == watch.primitive.exchange(primitive))
+            armed.fetch_add(1);
+    }
+
+    void disarm(Watch &watch)
+    {
+        if (nullptr != watch.primitive.exchange(nullptr))
+            armed.fetch_sub(1);
+    }
+
+    // NOTE: Only the signaller that clears a watch gives its waker, so a disarm racing with it can't double count
+    [[nodiscard]] IRAM_ATTR static notification::Notification *fire(Watch &watch, const void *primitive)
+    {
+        auto expected = primitive;
+        if (primitive != watch.primitive.load() or not watch.primitive.compare_exchange_strong(expected, nullptr))
+            return nullptr;
+
+        armed.fetch_sub(1);
+        return watch.waker.load();
+    }
+
+    bool any_armed()
+    {
+        return 0 != armed.load();
+    }
+
+    void signal(const void *primitive)
+    {
+        if (not any_armed())
+            return;
+
+        for (auto &watch : watches)
+            if (auto waker = fire(watch, primitive))
+                notification::give(*waker);
+    }
+
+    void signal_from_isr(const void *primitive)
+    {
+        if (not any_armed())
+            return;
+
+        for (auto &watch : watches)
+            if (auto waker = fire(watch, primitive))
+                notification::give_from_isr(*waker);
+    }
+
+} // namespace coro
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "esp_system.h"
+
+#include "notification.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace coro
+{
+
+    static constexpr std::size_t max_watches{16};
+
+    // NOTE: A suspended flow's interest in the primitive it waits on, so whoever gives, sets or pushes it wakes the scheduler instead of the
+    // scheduler polling on a timer. Watches live in a static table that the signalling side scans, so an ISR never follows a pointer into a
+    // scheduler's memory to find one; a scheduler claims one per flow slot for as long as it exists.
+    struct Watch
+    {
+        std::atomic<const void *> primitive{nullptr}; // NOTE: Cleared by the first signal, so a burst of them is a single wake
+        std::atomic<notification::Notification *> waker{nullptr};
+    };
+
+    // NOTE: nullptr once the table is full; flows on a slot without a watch fall back to the scheduler's poll interval
+    [[nodiscard]] Watch *claim_watch(notification::Notification &waker);
+    void release_watch(Watch &watch);
+
+    // NOTE: Arm before polling the primitive, so a signal that lands between a failed poll and going to sleep still wakes the scheduler
+    void arm(Watch &watch, const void *primitive);
+    void disarm(Watch &watch);
+
+    // NOTE: Lets a signaller skip costly work, such as deferring a signal from an ISR, when no flow is waiting on anything
+    [[nodiscard]] IRAM_ATTR bool any_armed();
+
+    // NOTE: Called by the primitive wrappers after every give, set or push; a single atomic load when nothing is being watched
+    void signal(const void *primitive);
+    IRAM_ATTR void signal_from_isr(const void *primitive);
+
+} // namespace coro
\ No newline at end of file
@@ -0,0 +1,123 @@
+// Bounce-trace tests for gpio::Debouncer, the dead-time filter the GPIO ISRs run on every edge:
+//
+//     g++ -std=c++20 -O2 -I tools/host -I main tools/debounce_test.cpp -o debounce_test && ./debounce_test
+//
+// Each trace is the edge stream an ISR would see from a bouncing contact, as (time, sampled level) pairs; the test feeds it through the
+// debouncer and checks which edges come out and how many were rejected.
+
+#include "debounce.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+
+    struct Edge
+    {
+        std::int64_t us;
+        int level;
+    };
+
+    struct Trace
+    {
+        const char *name;
+        std::int64_t deadtime_us;
+        bool track_level;
+        std::vector<Edge> edges;
+        std::vector<Edge> accepted; // NOTE: What the debouncer should let through
+    };
+
+    [[nodiscard]] bool run(const Trace &trace)
+    {
+        gpio::Debouncer debouncer{trace.deadtime_us, trace.track_level};
+        std::vector<Edge> accepted{};
+
+        for (const auto &edge : trace.edges)
+            if (debouncer.accept(edge.us, edge.level))
+                accepted.push_back(edge);
+
+        auto ok = accepted.size() == trace.accepted.size() and debouncer.rejected() == trace.edges.size() - trace.accepted.size();
+        for (std::size_t i = 0; ok and i < accepted.size(); ++i)
+            ok = accepted[i].us == trace.accepted[i].us and accepted[i].level == trace.accepted[i].level;
+
+        std::printf("%s: %s (%zu of %zu edges accepted, %lu rejected)\n", ok ? "OK  " : "FAIL", trace.name, accepted.size(),
+                    trace.edges.size(), static_cast<unsigned long>(debouncer.rejected()));
+        if (not ok)
+            for (const auto &edge : accepted)
+                std::printf("      accepted %lld us level %d\n", static_cast<long long>(edge.us), edge.level);
+
+        return ok;
+    }
+
+} // namespace
+
+int main()
+{
+    const std::initializer_list<Trace> traces{
+        {"clean press and release", 20'000, true, {{0, 0}, {300'000, 1}}, {{0, 0}, {300'000, 1}}},
+
+        {"press bouncing for 2 ms",
+         20'000,
+         true,
+         {{0, 0}, {180, 1}, {350, 0}, {900, 1}, {1'400, 0}, {2'100, 1}, {2'150, 0}, {250'000, 1}},
+         {{0, 0}, {250'000, 1}}},
+
+        {"release bouncing for 5 ms",
+         20'000,
+         true,
+         {{0, 0}, {400'000, 1}, {400'120, 0}, {401'000, 1}, {403'500, 0}, {404'900, 1}},
+         {{0, 0}, {400'000, 1}}},
+
+        // NOTE: A bounce straddling the dead-time leaves the level unchanged, so it must not produce a second press
+        {"bounce just after the dead-time",
+         5'000,
+         true,
+         {{0, 0}, {4'000, 1}, {5'200, 0}, {5'300, 1}, {60'000, 1}},
+         {{0, 0}, {5'300, 1}}},
+
+        // NOTE: Any-edge interrupts can deliver the same level twice when a bounce is shorter than the ISR latency
+        {"repeated level",
+         1'000,
+         true,
+         {{0, 0}, {10'000, 0}, {20'000, 1}, {30'000, 1}, {40'000, 0}},
+         {{0, 0}, {20'000, 1}, {40'000, 0}}},
+
+        // NOTE: Single-edge interrupts only see one direction, so levels aren't compared and only the dead-time filters
+        {"rising-edge only", 10'000, false, {{0, 1}, {2'000, 1}, {9'999, 1}, {10'000, 1}, {25'000, 1}}, {{0, 1}, {10'000, 1}, {25'000, 1}}},
+
+        // NOTE: A real change inside the dead-time is dropped, but the level it settled at is remembered: the next press repeats the last
+        // accepted level, yet still comes through since the pin was released for longer than a dead-time in between
+        {"release inside the dead-time",
+         20'000,
+         true,
+         {{0, 0}, {8'000, 1}, {90'000, 0}, {95'000, 1}, {95'400, 0}, {300'000, 1}},
+         {{0, 0}, {90'000, 0}, {300'000, 1}}},
+
+        // NOTE: The same repeat after a short excursion is a bounce, not a lost change
+        {"bounce inside the dead-time",
+         20'000,
+         true,
+         {{0, 0}, {8'000, 1}, {12'000, 0}, {30'000, 0}, {50'000, 1}},
+         {{0, 0}, {50'000, 1}}},
+
+        {"zero dead-time", 0, true, {{0, 0}, {1, 1}, {2, 0}, {2, 0}}, {{0, 0}, {1, 1}, {2, 0}}},
+
+    };
+
+    auto ok = true;
+    for (const auto &trace : traces)
+        ok = run(trace) and ok;
+
+    gpio::Debouncer debouncer{20'000, true}; // NOTE: reset() forgets the last edge, e.g. when the pin is reconfigured
+    const auto first = debouncer.accept(0, 0);
+    debouncer.reset();
+    const auto after_reset = debouncer.accept(100, 0);
+    const auto reset_ok = first and after_reset and 0 == debouncer.rejected();
+    std::printf("%s: reset accepts the next edge\n", reset_ok ? "OK  " : "FAIL");
+
+    return ok and reset_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
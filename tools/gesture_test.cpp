@@ -0,0 +1,154 @@
+// Trace tests for gpio::GestureEngine fed through gpio::Debouncer, the same pipeline gpio_main runs on the button:
+//
+//     g++ -std=c++20 -O2 -I tools/host -I main tools/gesture_test.cpp -o gesture_test && ./gesture_test
+//
+// Each trace is a recorded-style stream of raw edges, bounces included, plus the points where the task wakes on a deadline or at the end
+// of an edge's dead-time and reads the live pin level. The edges go through a 20 ms dead-time debouncer as in the ISR; the test checks the gestures and when they were reported.
+
+#include "debounce.hpp"
+#include "gesture.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+
+    enum class Kind
+    {
+        Edge,   // NOTE: Seen by the ISR
+        Wake,   // NOTE: The task wakes on a deadline and polls with the level read off the pin
+        Settle, // NOTE: The task wakes as an edge's dead-time runs out and settles on the level read off the pin
+    };
+
+    struct Sample
+    {
+        std::int64_t us;
+        int level;
+        Kind kind;
+    };
+
+    struct Reported
+    {
+        gpio::Gesture gesture;
+        std::int64_t us;
+    };
+
+    struct Trace
+    {
+        const char *name;
+        std::vector<Sample> samples;
+        std::vector<Reported> expected;
+    };
+
+    constexpr std::int64_t deadtime_us{20'000};
+
+    [[nodiscard]] constexpr Sample edge(std::int64_t us, int level) { return {us, level, Kind::Edge}; }
+    [[nodiscard]] constexpr Sample wake(std::int64_t us, int level) { return {us, level, Kind::Wake}; }
+    [[nodiscard]] constexpr Sample settle(std::int64_t us, int level) { return {us, level, Kind::Settle}; }
+
+    [[nodiscard]] bool run(const Trace &trace)
+    {
+        gpio::Debouncer debouncer{deadtime_us, true};
+        gpio::GestureEngine engine{};
+        std::vector<Reported> reported{};
+
+        auto record = [&reported](gpio::Gesture gesture, std::int64_t at_us) { reported.push_back({gesture, at_us}); };
+
+        for (const auto &sample : trace.samples)
+        {
+            switch (sample.kind)
+            {
+            case Kind::Edge:
+                if (debouncer.accept(sample.us, sample.level))
+                    engine.feed(sample.us, sample.level, record);
+                break;
+            case Kind::Wake:
+                engine.poll(sample.us, sample.level, record);
+                break;
+            case Kind::Settle:
+                engine.settle(sample.us, sample.level, record);
+                break;
+            }
+        }
+
+        auto ok = reported.size() == trace.expected.size();
+        for (std::size_t i = 0; ok and i < reported.size(); ++i)
+            ok = reported[i].gesture == trace.expected[i].gesture and reported[i].us == trace.expected[i].us;
+
+        std::printf("%s: %s\n", ok ? "OK  " : "FAIL", trace.name);
+        if (not ok)
+            for (const auto &gesture : reported)
+                std::printf("      %s at %lld us\n", gpio::gesture_to_string(gesture.gesture).data(), static_cast<long long>(gesture.us));
+
+        return ok;
+    }
+
+} // namespace
+
+int main()
+{
+    using gpio::Gesture;
+
+    const std::initializer_list<Trace> traces{
+        {"click with bouncy contacts",
+         {edge(0, 1), edge(300, 0), edge(800, 1), edge(120'000, 0), edge(120'400, 1), edge(121'000, 0), wake(420'000, 0)},
+         {{Gesture::Click, 420'000}}},
+
+        {"double click",
+         {edge(0, 1), edge(90'000, 0), edge(200'000, 1), edge(200'500, 0), edge(201'000, 1), edge(290'000, 0)},
+         {{Gesture::DoubleClick, 290'000}}},
+
+        {"second press after the gap is two clicks",
+         {edge(0, 1), edge(100'000, 0), wake(400'000, 0), edge(450'000, 1), edge(550'000, 0), wake(850'000, 0)},
+         {{Gesture::Click, 400'000}, {Gesture::Click, 850'000}}},
+
+        {"long press with repeats",
+         {edge(0, 1), edge(700, 0), edge(1'200, 1), wake(1'000'000, 1), wake(1'200'000, 1), wake(1'400'000, 1), edge(1'500'000, 0)},
+         {{Gesture::LongPress, 1'000'000}, {Gesture::Repeat, 1'200'000}, {Gesture::Repeat, 1'400'000}}},
+
+        // NOTE: A late wake still reports every repeat that fell due, at the times they were due
+        {"late wake during a hold",
+         {edge(0, 1), wake(1'000'000, 1), wake(1'450'000, 1), edge(1'460'000, 0)},
+         {{Gesture::LongPress, 1'000'000}, {Gesture::Repeat, 1'200'000}, {Gesture::Repeat, 1'400'000}}},
+
+        // NOTE: The release lands inside the dead-time and is dropped; the pin reads released once the dead-time is over, so it's a click
+        {"release lost in the dead-time",
+         {edge(0, 1), edge(15'000, 0), settle(20'000, 0), wake(320'000, 0)},
+         {{Gesture::Click, 320'000}}},
+
+        // NOTE: Without the settle wake, the release is still recovered at the long press deadline
+        {"release lost in the dead-time, no settle",
+         {edge(0, 1), edge(15'000, 0), wake(1'000'000, 0), wake(1'300'000, 0)},
+         {{Gesture::Click, 1'300'000}}},
+
+        // NOTE: The next press repeats the last debounced level; the debouncer lets it through and the engine replays the lost release
+        {"double click starting with a lost release",
+         {edge(0, 1), edge(15'000, 0), edge(150'000, 1), edge(150'300, 0), edge(150'700, 1), edge(250'000, 0)},
+         {{Gesture::DoubleClick, 250'000}}},
+
+        // NOTE: Same, with the settle wake having caught the release already
+        {"double click starting with a settled release",
+         {edge(0, 1), edge(15'000, 0), settle(20'000, 0), edge(150'000, 1), edge(250'000, 0)},
+         {{Gesture::DoubleClick, 250'000}}},
+
+        // NOTE: A quick re-press after a click, whose release then falls in the new press's dead-time
+        {"tap lost after a click",
+         {edge(0, 1), edge(100'000, 0), wake(400'000, 0), edge(600'000, 1), edge(610'000, 0), wake(1'600'000, 0), wake(1'900'000, 0)},
+         {{Gesture::Click, 400'000}, {Gesture::Click, 1'900'000}}},
+
+        // NOTE: A press still being queued when the gap runs out is left for its own edge, not merged into a double click
+        {"press racing the double click deadline",
+         {edge(0, 1), edge(100'000, 0), wake(400'000, 1), edge(400'050, 1), edge(500'000, 0), wake(800'000, 0)},
+         {{Gesture::Click, 400'000}, {Gesture::Click, 800'000}}},
+    };
+
+    auto ok = true;
+    for (const auto &trace : traces)
+        ok = run(trace) and ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
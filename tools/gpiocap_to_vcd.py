@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Convert a GPIO capture (gpio::Capture) to a VCD file PulseView can open.
+
+The input is either the raw export_binary() output or a serial log containing
+the "GCAP:" hex lines printed by Capture::dump().
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+HEADER = struct.Struct("<4sHHIIQq")
+SAMPLE = struct.Struct("<IQQ")
+NO_TRIGGER = 0xFFFFFFFF
+
+
+def load(path):
+    with open(path, "rb") as file:
+        data = file.read()
+
+    if data.startswith(b"GCAP") and not data.startswith(b"GCAP:"):
+        return data
+
+    lines = re.findall(rb"GCAP:([0-9a-fA-F]+)", data)
+    if not lines:
+        sys.exit(f"{path}: no capture found")
+    return bytes.fromhex(b"".join(lines).decode())
+
+
+def parse(data):
+    magic, version, sample_size, count, trigger, pins, start = HEADER.unpack_from(data)
+    if magic != b"GCAP" or version != 1 or sample_size != SAMPLE.size:
+        sys.exit("unsupported capture format")
+
+    samples = [SAMPLE.unpack_from(data, HEADER.size + i * sample_size) for i in range(count)]
+    return pins, start, trigger, samples
+
+
+def identifier(index):
+    # NOTE: Printable VCD identifiers starting at '!'
+    chars = ""
+    index += 1
+    while index:
+        index, digit = divmod(index - 1, 94)
+        chars = chr(33 + digit) + chars
+    return chars
+
+
+def write_vcd(out, pins, start, trigger, samples):
+    channels = [pin for pin in range(64) if pins >> pin & 1]
+    ids = {pin: identifier(i) for i, pin in enumerate(channels)}
+
+    out.write(f"$comment GPIO capture, start {start} us")
+    if trigger != NO_TRIGGER:
+        out.write(f", trigger at sample {trigger}")
+    out.write(" $end\n$timescale 1us $end\n$scope module gpio $end\n")
+    for pin in channels:
+        out.write(f"$var wire 1 {ids[pin]} GPIO{pin} $end\n")
+    out.write("$upscope $end\n$enddefinitions $end\n")
+
+    if not samples:
+        return
+
+    # NOTE: The levels before the first edge are its levels with the changed pins flipped back
+    _, changed, levels = samples[0]
+    previous = levels ^ changed
+    out.write("#0\n$dumpvars\n")
+    for pin in channels:
+        out.write(f"{previous >> pin & 1}{ids[pin]}\n")
+    out.write("$end\n")
+
+    time = 0  # NOTE: $dumpvars already sits at #0, where the first sample normally lands too
+    for offset, changed, levels in samples:
+        if offset != time:
+            out.write(f"#{offset}\n")
+            time = offset
+        for pin in channels:
+            if (levels ^ previous) >> pin & 1:
+                out.write(f"{levels >> pin & 1}{ids[pin]}\n")
+        previous = levels
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", help="binary export or serial log with GCAP: lines")
+    parser.add_argument("output", nargs="?", help="VCD file (stdout if omitted)")
+    args = parser.parse_args()
+
+    capture = parse(load(args.input))
+
+    if args.output:
+        with open(args.output, "w") as out:
+            write_vcd(out, *capture)
+    else:
+        write_vcd(sys.stdout, *capture)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,6 @@
+#pragma once
+
+// NOTE: Host stand-in for ESP-IDF's esp_attr.h, so headers that only need the placement attributes build off-target
+
+#define IRAM_ATTR
+#define DRAM_ATTR
\ No newline at end of file
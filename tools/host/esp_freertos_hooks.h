@@ -0,0 +1,12 @@
+#pragma once
+
+// NOTE: Host stand-in for ESP-IDF's esp_freertos_hooks.h; the shim has no tick interrupt, so registered hooks never run
+
+#include "esp_err.h"
+
+#include <cstdint>
+
+typedef void (*esp_freertos_tick_cb_t)();
+
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t fn, std::uint32_t core);
+void esp_deregister_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t fn, std::uint32_t core);
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+// NOTE: Host stand-in for ESP-IDF's esp_log.h; everything at or below LOG_LOCAL_LEVEL goes to stdout
+
+#include <cstdarg>
+#include <cstdio>
+
+#define ESP_LOG_NONE 0
+#define ESP_LOG_ERROR 1
+#define ESP_LOG_WARN 2
+#define ESP_LOG_INFO 3
+#define ESP_LOG_DEBUG 4
+#define ESP_LOG_VERBOSE 5
+
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO // NOTE: The sdkconfig default
+#endif
+
+// NOTE: Not declared printf-like on purpose; the formats are written for the target, where uint32_t is unsigned long
+inline void esp_host_log(const char *format, ...)
+{
+    std::va_list args;
+    va_start(args, format);
+    std::vprintf(format, args);
+    va_end(args);
+}
+
+#define ESP_HOST_LOG(level, letter, tag, format, ...)                                           \
+    do                                                                                          \
+    {                                                                                           \
+        if (LOG_LOCAL_LEVEL >= level)                                                           \
+            esp_host_log(letter " (%s): " format "\n", tag __VA_OPT__(, ) __VA_ARGS__);         \
+    } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_HOST_LOG(ESP_LOG_ERROR, "E", tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_HOST_LOG(ESP_LOG_WARN, "W", tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_HOST_LOG(ESP_LOG_INFO, "I", tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_HOST_LOG(ESP_LOG_DEBUG, "D", tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_HOST_LOG(ESP_LOG_VERBOSE, "V", tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_DRAM_LOGE(tag, format, ...) ESP_LOGE(tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_DRAM_LOGW(tag, format, ...) ESP_LOGW(tag, format __VA_OPT__(, ) __VA_ARGS__)
+#define ESP_DRAM_LOGD(tag, format, ...) ESP_LOGD(tag, format __VA_OPT__(, ) __VA_ARGS__)
+
+inline void esp_log_level_set(const char *, int) {}
\ No newline at end of file
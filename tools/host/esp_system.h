@@ -0,0 +1,5 @@
+#pragma once
+
+// NOTE: Host stand-in for ESP-IDF's esp_system.h; the wrappers only pull it in for the placement attributes
+
+#include "esp_attr.h"
\ No newline at end of file
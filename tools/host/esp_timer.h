@@ -0,0 +1,7 @@
+#pragma once
+
+// NOTE: Host stand-in for ESP-IDF's esp_timer.h; each test supplies the clock, so it can step time deterministically
+
+#include <cstdint>
+
+std::int64_t esp_timer_get_time();
\ No newline at end of file
@@ -0,0 +1,337 @@
+// Threads-based stand-in for the FreeRTOS calls the wrappers make, so their sources link into host tests (see host_tests.sh). Only the
+// semantics the wrappers rely on are modelled: blocking with a tick timeout, binary and counting semaphores, indexed notifications and
+// event group bits. There is no scheduler, priority or ISR context; a "FromISR" call is the task call and never asks for a yield.
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+
+#include "esp_freertos_hooks.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct HostTask
+{
+    const char *name;
+    std::atomic<bool> deleted{false};
+    std::array<std::uint32_t, configTASK_NOTIFICATION_ARRAY_ENTRIES> notifications{}; // NOTE: Guarded by notification_mutex
+};
+
+struct HostSemaphore
+{
+    std::mutex mutex;
+    std::condition_variable available;
+    UBaseType_t count;
+    UBaseType_t max_count;
+};
+
+struct HostEventGroup
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    EventBits_t bits{0};
+};
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+    using Tick = std::chrono::duration<std::int64_t, std::ratio<1, configTICK_RATE_HZ>>;
+
+    const auto epoch = Clock::now();
+
+    std::mutex tasks_mutex;
+    std::vector<HostTask *> tasks; // NOTE: Never freed, so a handle stays valid for uxTaskGetSystemState after its task is deleted
+
+    std::mutex notification_mutex;
+    std::condition_variable notified;
+
+    thread_local HostTask *current{nullptr};
+
+    HostTask *register_task(const char *name)
+    {
+        auto task = new HostTask{name};
+        std::scoped_lock lock{tasks_mutex};
+        tasks.push_back(task);
+        return task;
+    }
+
+    // NOTE: Waits on cv until pred holds or the tick timeout runs out; portMAX_DELAY waits forever
+    template <class Lock, class Predicate>
+    bool wait_ticks(std::condition_variable &cv, Lock &lock, TickType_t ticks, Predicate pred)
+    {
+        if (portMAX_DELAY == ticks)
+        {
+            cv.wait(lock, pred);
+            return true;
+        }
+
+        return cv.wait_for(lock, Tick{ticks}, pred);
+    }
+
+} // namespace
+
+BaseType_t xPortGetCoreID() { return 0; }
+BaseType_t xPortInIsrContext() { return pdFALSE; }
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, std::uint32_t, void *arg, UBaseType_t, TaskHandle_t *handle, BaseType_t)
+{
+    const auto task = register_task(name);
+    if (handle)
+        *handle = task;
+
+    std::thread{[task, fn, arg]
+                {
+                    current = task;
+                    fn(arg);
+                }}
+        .detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, std::uint32_t stack_size, void *arg, UBaseType_t priority, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_size, arg, priority, handle, tskNO_AFFINITY);
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, std::uint32_t stack_size, void *arg, UBaseType_t priority, StackType_t *,
+                               StaticTask_t *)
+{
+    TaskHandle_t handle{nullptr};
+    (void)xTaskCreate(fn, name, stack_size, arg, priority, &handle);
+    return handle;
+}
+
+// NOTE: A thread can't be killed, so deleting another task only hides it from uxTaskGetSystemState; a task deleting itself parks forever
+void vTaskDelete(TaskHandle_t task)
+{
+    const auto self = xTaskGetCurrentTaskHandle();
+    if (nullptr == task)
+        task = self;
+
+    task->deleted = true;
+    if (task == self)
+        while (true)
+            std::this_thread::sleep_for(std::chrono::hours{1});
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (portMAX_DELAY == ticks)
+        while (true)
+            std::this_thread::sleep_for(std::chrono::hours{1});
+
+    std::this_thread::sleep_for(Tick{ticks});
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake, TickType_t increment)
+{
+    const auto target = *previous_wake + increment;
+    const auto now = xTaskGetTickCount();
+    *previous_wake = target;
+
+    if (static_cast<TickType_t>(now - (target - increment)) >= increment) // NOTE: Already due, FreeRTOS returns without blocking
+        return pdFALSE;
+
+    std::this_thread::sleep_until(epoch + Tick{target});
+    return pdTRUE;
+}
+
+void taskYIELD() { std::this_thread::yield(); }
+
+TickType_t xTaskGetTickCount() { return static_cast<TickType_t>(std::chrono::duration_cast<Tick>(Clock::now() - epoch).count()); }
+TickType_t xTaskGetTickCountFromISR() { return xTaskGetTickCount(); }
+
+// NOTE: Threads the shim didn't start, main() included, get a handle the first time they ask
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    if (nullptr == current)
+        current = register_task("host");
+    return current;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t) { return nullptr; }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 1024; }
+
+UBaseType_t uxTaskGetNumberOfTasks()
+{
+    std::scoped_lock lock{tasks_mutex};
+    UBaseType_t count{0};
+    for (const auto task : tasks)
+        count += not task->deleted;
+    return count;
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t entries, std::uint32_t *total_runtime)
+{
+    std::scoped_lock lock{tasks_mutex};
+    UBaseType_t count{0};
+
+    for (const auto task : tasks)
+    {
+        if (task->deleted)
+            continue;
+        if (count == entries)
+            return 0; // NOTE: Like FreeRTOS, a short array gets nothing
+        auto &entry = status[count++];
+        entry = TaskStatus_t{};
+        entry.xHandle = task;
+        entry.pcTaskName = task->name;
+        entry.eCurrentState = eReady;
+        entry.usStackHighWaterMark = uxTaskGetStackHighWaterMark(task);
+    }
+
+    if (total_runtime)
+        *total_runtime = 0;
+    return count;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+    configASSERT(index < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    std::scoped_lock lock{notification_mutex};
+    ++task->notifications[index];
+    notified.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *woken)
+{
+    (void)xTaskNotifyGiveIndexed(task, index);
+    if (woken)
+        *woken = pdFALSE;
+}
+
+std::uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_on_exit, TickType_t ticks)
+{
+    configASSERT(index < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    auto &value = xTaskGetCurrentTaskHandle()->notifications[index];
+
+    std::unique_lock lock{notification_mutex};
+    (void)wait_ticks(notified, lock, ticks, [&] { return value > 0; });
+
+    const auto taken = value;
+    if (taken)
+        value = clear_on_exit ? 0 : taken - 1;
+    return taken;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    auto semaphore = new HostSemaphore;
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t max_count, UBaseType_t initial_count, StaticSemaphore_t *)
+{
+    return xSemaphoreCreateCounting(max_count, initial_count);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return xSemaphoreCreateCounting(1, 0); }
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *) { return xSemaphoreCreateBinary(); }
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    std::unique_lock lock{semaphore->mutex};
+    if (not wait_ticks(semaphore->available, lock, ticks, [&] { return semaphore->count > 0; }))
+        return pdFAIL;
+
+    --semaphore->count;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    std::scoped_lock lock{semaphore->mutex};
+    if (semaphore->count >= semaphore->max_count)
+        return pdFAIL;
+
+    ++semaphore->count;
+    semaphore->available.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *woken)
+{
+    if (woken)
+        *woken = pdFALSE;
+    return xSemaphoreGive(semaphore);
+}
+
+EventGroupHandle_t xEventGroupCreate() { return new HostEventGroup; }
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *) { return xEventGroupCreate(); }
+void vEventGroupDelete(EventGroupHandle_t group) { delete group; }
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+    std::scoped_lock lock{group->mutex};
+    return group->bits;
+}
+
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t group) { return xEventGroupGetBits(group); }
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::scoped_lock lock{group->mutex};
+    group->changed.notify_all();
+    return group->bits |= bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t group, EventBits_t bits, BaseType_t *woken)
+{
+    if (woken)
+        *woken = pdFALSE;
+    (void)xEventGroupSetBits(group, bits);
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::scoped_lock lock{group->mutex};
+    const auto before = group->bits;
+    group->bits &= ~bits;
+    return before;
+}
+
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t group, EventBits_t bits)
+{
+    (void)xEventGroupClearBits(group, bits);
+    return pdPASS;
+}
+
+// NOTE: Returns the bits as they were when the wait ended, before any clear, like FreeRTOS
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_for_all, TickType_t ticks)
+{
+    std::unique_lock lock{group->mutex};
+    const auto satisfied = [&] { return wait_for_all ? (group->bits & bits) == bits : (group->bits & bits) != 0; };
+
+    (void)wait_ticks(group->changed, lock, ticks, satisfied);
+    const auto before = group->bits;
+    if (satisfied() and clear_on_exit)
+        group->bits &= ~bits;
+    return before;
+}
+
+// NOTE: Runs the call straight away rather than on a timer task; the wrappers only pend to get out of ISR context
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t fn, void *arg1, std::uint32_t arg2, BaseType_t *woken)
+{
+    if (woken)
+        *woken = pdFALSE;
+    fn(arg1, arg2);
+    return pdPASS;
+}
+
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t, std::uint32_t) { return ESP_OK; }
+void esp_deregister_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t, std::uint32_t) {}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+// NOTE: Host stand-in for the slice of ESP-IDF's FreeRTOS the wrappers use. Tasks are std::threads and a tick is 10 ms of steady_clock,
+// matching CONFIG_FREERTOS_HZ=100; freertos.cpp has the implementation. Critical sections are a plain spinlock, there is no ISR context.
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+
+#define configTICK_RATE_HZ 100
+#define configMAX_PRIORITIES 25
+#define configMAX_TASK_NAME_LEN 16
+#define configGENERATE_RUN_TIME_STATS 1
+#define configUSE_TRACE_FACILITY 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configASSERT(x) assert(x)
+
+#define portNUM_PROCESSORS 2
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY 0xffffffffu
+#define portYIELD_FROM_ISR() \
+    do                       \
+    {                        \
+    } while (0)
+
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>((ms) / portTICK_PERIOD_MS))
+#define pdTICKS_TO_MS(ticks) (static_cast<std::uint32_t>((ticks) * portTICK_PERIOD_MS))
+
+#define tskNO_AFFINITY 0x7fffffff
+
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef std::uint32_t TickType_t;
+typedef std::uint8_t StackType_t;
+
+typedef struct StaticQueue
+{
+    void *handle;
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+typedef struct StaticTask
+{
+    void *handle;
+} StaticTask_t;
+
+typedef struct StaticEventGroup
+{
+    void *handle;
+} StaticEventGroup_t;
+
+typedef struct
+{
+    std::uint32_t owner;
+    std::uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+
+inline void portENTER_CRITICAL(portMUX_TYPE *mux)
+{
+    std::atomic_ref<std::uint32_t> owner{mux->owner};
+    for (std::uint32_t unlocked = 0; not owner.compare_exchange_weak(unlocked, 1, std::memory_order_acquire); unlocked = 0)
+        ;
+}
+
+inline void portEXIT_CRITICAL(portMUX_TYPE *mux) { std::atomic_ref<std::uint32_t>{mux->owner}.store(0, std::memory_order_release); }
+
+inline void portENTER_CRITICAL_ISR(portMUX_TYPE *mux) { portENTER_CRITICAL(mux); }
+inline void portEXIT_CRITICAL_ISR(portMUX_TYPE *mux) { portEXIT_CRITICAL(mux); }
+inline void portENTER_CRITICAL_SAFE(portMUX_TYPE *mux) { portENTER_CRITICAL(mux); }
+inline void portEXIT_CRITICAL_SAFE(portMUX_TYPE *mux) { portEXIT_CRITICAL(mux); }
+
+BaseType_t xPortGetCoreID();
+BaseType_t xPortInIsrContext();
\ No newline at end of file
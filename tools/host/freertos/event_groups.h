@@ -0,0 +1,18 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef struct HostEventGroup *EventGroupHandle_t;
+typedef std::uint32_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate();
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *storage);
+void vEventGroupDelete(EventGroupHandle_t group);
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group);
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t group);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t group, EventBits_t bits, BaseType_t *woken);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits);
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit, BaseType_t wait_for_all, TickType_t ticks);
\ No newline at end of file
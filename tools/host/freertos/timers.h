@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*PendedFunction_t)(void *, std::uint32_t);
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t fn, void *arg1, std::uint32_t arg2, BaseType_t *woken);
\ No newline at end of file
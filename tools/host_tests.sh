@@ -0,0 +1,27 @@
+#!/usr/bin/env sh
+# Builds and runs the host-side tests. tools/host stands in for the ESP-IDF headers they need; the wrapper sources below are built against
+# its FreeRTOS shim into a library every test links, so a test only pulls in the wrappers it actually calls.
+set -e
+
+cd "$(dirname "$0")/.."
+out="${TMPDIR:-/tmp}/host_tests"
+mkdir -p "$out/lib"
+
+cxx="${CXX:-g++}"
+flags="-std=c++20 -O2 -Wall -Wextra -pthread -I tools/host -I main -I main/wrappers"
+
+rm -f "$out/lib/"*.o "$out/libhost.a"
+for source in tools/host/freertos.cpp main/wrappers/semphr.cpp main/wrappers/notification.cpp main/wrappers/watch.cpp \
+    main/wrappers/task.cpp main/wrappers/taskstats.cpp main/wrappers/stackprofiler.cpp main/wrappers/coroutine.cpp \
+    main/wrappers/eventgroup.cpp; do
+    $cxx $flags -c "$source" -o "$out/lib/$(basename "$source" .cpp).o"
+done
+ar rcs "$out/libhost.a" "$out/lib/"*.o
+
+for test in tools/*_test.cpp tools/*_stress.cpp; do
+    [ -e "$test" ] || continue
+    name="$(basename "$test" .cpp)"
+    echo "== $name"
+    $cxx $flags "$test" "$out/libhost.a" -o "$out/$name"
+    "$out/$name"
+done
@@ -0,0 +1,177 @@
+// Tests for queue::Mailbox, the latest-value-per-key mailbox, against the FreeRTOS shim in tools/host:
+//
+//     tools/host_tests.sh
+//
+// It links against tools/host/freertos.cpp and the wrapper sources, which host_tests.sh builds into a library for the tests that need it.
+//
+// Covers draining and coalescing, the seqlock in latest() under a concurrent writer, a stale wake (given for keys an earlier drain
+// already took) waiting out the rest of the timeout rather than returning early, and a post from another task ending the wait.
+
+#include "mailbox.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+
+std::int64_t esp_timer_get_time()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace
+{
+
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    struct Item
+    {
+        std::uint64_t sequence{0};
+        std::uint64_t check{0}; // NOTE: Derived from sequence, so a torn copy shows up as a mismatch
+    };
+
+    [[nodiscard]] constexpr std::uint64_t check_of(std::uint64_t sequence) { return ~sequence * 0x9E3779B97F4A7C15ull; }
+
+    [[nodiscard]] bool report(bool ok, const char *name)
+    {
+        std::printf("%s: %s\n", ok ? "OK  " : "FAIL", name);
+        return ok;
+    }
+
+    [[nodiscard]] auto elapsed_ms(Clock::time_point since)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+    }
+
+    [[nodiscard]] bool drain_in_key_order()
+    {
+        queue::Mailbox<int, 40> mailbox{}; // NOTE: More than one pending word
+        mailbox.post(33, 3);
+        mailbox.post(1, 1);
+        mailbox.post(7, 2);
+
+        std::vector<std::pair<std::size_t, int>> drained{};
+        const auto count = mailbox.drain([&](std::size_t key, int value) { drained.emplace_back(key, value); });
+        const auto again = mailbox.drain([](std::size_t, int) {});
+
+        const std::vector<std::pair<std::size_t, int>> expected{{1, 1}, {7, 2}, {33, 3}};
+        return report(3 == count and drained == expected and 0 == again and not mailbox.is_pending(1), "drain visits each posted key once");
+    }
+
+    [[nodiscard]] bool coalesce()
+    {
+        queue::Mailbox<int, 4> mailbox{};
+        for (int value = 1; value <= 5; ++value)
+            mailbox.post(2, value);
+
+        std::vector<int> values{};
+        const auto pending = mailbox.is_pending(2);
+        const auto count = mailbox.drain([&](std::size_t, int value) { values.push_back(value); });
+
+        return report(pending and 1 == count and values == std::vector<int>{5} and 5 == mailbox.latest(2), "posts to one key coalesce");
+    }
+
+    // NOTE: The writer only stores while the reader copies, so every copy latest() hands back must be whole and never go backwards
+    [[nodiscard]] bool seqlock(std::uint64_t items)
+    {
+        static queue::Mailbox<Item> mailbox{};
+        mailbox.post(Item{0, check_of(0)});
+
+        std::thread writer{[items]
+                           {
+                               for (std::uint64_t i = 1; i <= items; ++i)
+                                   mailbox.post(Item{i, check_of(i)});
+                           }};
+
+        std::uint64_t last{0};
+        std::uint64_t reads{0};
+        auto ok = true;
+        while (ok and last < items)
+        {
+            const auto item = mailbox.latest();
+            ok = item.check == check_of(item.sequence) and item.sequence >= last;
+            if (not ok)
+                std::printf("      read %llu after %llu (check %s)\n", static_cast<unsigned long long>(item.sequence),
+                            static_cast<unsigned long long>(last), item.check == check_of(item.sequence) ? "ok" : "torn");
+            last = item.sequence;
+            ++reads;
+        }
+
+        writer.join();
+        std::printf("      %llu reads while %llu items were posted\n", static_cast<unsigned long long>(reads), static_cast<unsigned long long>(items));
+        return report(ok, "latest() never returns a torn or older value");
+    }
+
+    [[nodiscard]] bool drain_wait_takes_its_wake()
+    {
+        queue::Mailbox<int> mailbox{};
+        mailbox.post(1);
+
+        const auto first = mailbox.drain_wait([](std::size_t, int) {}, 0ms);
+        const auto start = Clock::now();
+        const auto second = mailbox.drain_wait([](std::size_t, int) {}, 50ms);
+        const auto waited = elapsed_ms(start);
+
+        return report(1 == first and 0 == second and waited >= 40, "drain_wait drops the wake for what it drained");
+    }
+
+    // NOTE: drain() leaves the wake given, so the next drain_wait wakes at once, finds nothing and has to wait out the rest of its timeout
+    [[nodiscard]] bool stale_wake()
+    {
+        queue::Mailbox<int, 4> mailbox{};
+        mailbox.post(2, 7);
+        (void)mailbox.drain([](std::size_t, int) {});
+
+        const auto start = Clock::now();
+        const auto count = mailbox.drain_wait([](std::size_t, int) {}, 100ms);
+        const auto waited = elapsed_ms(start);
+
+        std::printf("      stale wake returned %zu after %lld ms\n", count, static_cast<long long>(waited));
+        return report(0 == count and waited >= 90, "a stale wake waits out the timeout");
+    }
+
+    [[nodiscard]] bool post_ends_wait()
+    {
+        queue::Mailbox<int, 4> mailbox{};
+        std::thread poster{[&]
+                           {
+                               std::this_thread::sleep_for(30ms);
+                               mailbox.post(3, 9);
+                           }};
+
+        std::size_t key{0};
+        int value{0};
+        const auto start = Clock::now();
+        const auto count = mailbox.drain_wait(
+            [&](std::size_t k, int v)
+            {
+                key = k;
+                value = v;
+            },
+            1000ms);
+        const auto waited = elapsed_ms(start);
+        poster.join();
+
+        return report(1 == count and 3 == key and 9 == value and waited < 500, "a post from another task ends the wait");
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const std::uint64_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    auto ok = drain_in_key_order();
+    ok = coalesce() and ok;
+    ok = seqlock(items) and ok;
+    ok = drain_wait_takes_its_wake() and ok;
+    ok = stale_wake() and ok;
+    ok = post_ends_wait() and ok;
+
+    std::fflush(stdout);
+    std::_Exit(ok ? EXIT_SUCCESS : EXIT_FAILURE); // NOTE: Skips static destructors; shim tasks may still be parked on detached threads
+}
\ No newline at end of file
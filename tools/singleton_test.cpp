@@ -0,0 +1,176 @@
+// Tests for Singleton<T, singleton::Static>, the intrusively counted singleton behind wifi::Wifi and sc::SmartConfig, on the FreeRTOS shim:
+//
+//     tools/host_tests.sh
+//
+// Covers the instance's lifetime following its Refs, re-creating it after the last Ref is dropped without a stale WeakRef locking the new
+// instance, a get_shared racing the last release (the revive path), get_weak from another task waiting out a slow constructor and the
+// constructor calling get_weak on itself.
+
+#include "singleton.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    using namespace std::chrono_literals;
+
+    [[nodiscard]] bool report(bool ok, const char *name)
+    {
+        std::printf("%s: %s\n", ok ? "OK  " : "FAIL", name);
+        return ok;
+    }
+
+    // NOTE: Counts its constructions and destructions, and checks at most one instance is ever alive
+    template <int Tag>
+    class Counted : public Singleton<Counted<Tag>, singleton::Static>
+    {
+    public:
+        Counted() : magic{live_magic}
+        {
+            constructed.fetch_add(1);
+            if (1 != live.fetch_add(1) + 1)
+                overlapped = true;
+        }
+
+        ~Counted()
+        {
+            magic = 0;
+            live.fetch_sub(1);
+            destroyed.fetch_add(1);
+        }
+
+        [[nodiscard]] bool valid() const { return live_magic == magic; }
+
+        static constexpr std::uint32_t live_magic{0x5EED5EED};
+        static inline std::atomic<int> constructed{0};
+        static inline std::atomic<int> destroyed{0};
+        static inline std::atomic<int> live{0};
+        static inline std::atomic<bool> overlapped{false};
+
+    private:
+        volatile std::uint32_t magic{0};
+    };
+
+    [[nodiscard]] bool lifetime()
+    {
+        using S = Counted<0>;
+
+        auto first = S::get_shared();
+        const auto second = S::get_shared();
+        auto copy = first;
+        const auto shared = first.get() == second.get() and second.get() == copy.get() and 1 == S::constructed;
+
+        first.reset();
+        copy.reset();
+        const auto kept = 0 == S::destroyed and second->valid();
+
+        const auto weak = S::get_weak();
+        const auto alive = not weak.expired() and weak.lock().get() == second.get();
+
+        return report(shared and kept and alive, "Refs share one instance and keep it alive");
+    }
+
+    [[nodiscard]] bool recreate()
+    {
+        using S = Counted<1>;
+
+        auto ref = S::get_shared();
+        const auto stale = S::get_weak();
+        ref.reset();
+        const auto dropped = 1 == S::destroyed and stale.expired() and not stale.lock();
+
+        ref = S::get_shared(); // NOTE: Same storage, new generation
+        const auto recreated = 2 == S::constructed and ref->valid();
+        const auto still_stale = stale.expired() and not stale.lock();
+        const auto fresh = not S::get_weak().expired();
+        const auto default_expired = S::Weak{}.expired() and not S::Weak{}.lock();
+
+        return report(dropped and recreated and still_stale and fresh and default_expired,
+                      "dropping the last Ref destroys it, a stale WeakRef never locks the next instance");
+    }
+
+    // NOTE: Every release that takes the count to 0 races the other threads' get_shared; whichever way each race goes, a Ref must always
+    // point at a live instance and there must never be two
+    [[nodiscard]] bool revive(int iterations)
+    {
+        using S = Counted<2>;
+
+        std::atomic<bool> ok{true};
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back(
+                [&]
+                {
+                    for (int i = 0; i < iterations; ++i)
+                    {
+                        const auto ref = S::get_shared();
+                        if (not ref or not ref->valid())
+                            ok = false;
+                    }
+                });
+        for (auto &thread : threads)
+            thread.join();
+
+        const auto constructed = S::constructed.load();
+        std::printf("      %d instances constructed for %d get_shared calls\n", constructed, 4 * iterations);
+        return report(ok and not S::overlapped and 0 == S::live and constructed == S::destroyed,
+                      "get_shared racing the last release revives or re-creates, never both");
+    }
+
+    class Slow : public Singleton<Slow, singleton::Static>
+    {
+    public:
+        Slow() : self{get_weak()} // NOTE: Must not wait on the mutex this constructor is running under
+        {
+            self_expired = self.expired();
+            std::this_thread::sleep_for(100ms);
+        }
+
+        Weak self;
+        bool self_expired{false};
+    };
+
+    [[nodiscard]] bool construction()
+    {
+        std::atomic<bool> started{false};
+        std::thread creator{[&]
+                            {
+                                started = true;
+                                const auto ref = Slow::get_shared();
+                                std::this_thread::sleep_for(200ms);
+                            }};
+
+        while (not started)
+            std::this_thread::yield();
+        std::this_thread::sleep_for(20ms); // NOTE: Well inside the constructor's 100 ms
+
+        const auto weak = Slow::get_weak();
+        const auto ref = weak.lock();
+        const auto waited = not weak.expired() and ref;
+        const auto self = ref and ref->self_expired and not ref->self.expired() and ref->self.lock().get() == ref.get(); // NOTE: No Ref yet
+
+        creator.join();
+        return report(waited and self, "get_weak waits out the constructor, which can call it on itself");
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const auto iterations = argc > 1 ? std::atoi(argv[1]) : 200'000;
+
+    auto ok = lifetime();
+    ok = recreate() and ok;
+    ok = revive(iterations) and ok;
+    ok = construction() and ok;
+
+    std::fflush(stdout);
+    std::_Exit(ok ? EXIT_SUCCESS : EXIT_FAILURE); // NOTE: Skips static destructors; shim tasks may still be parked on detached threads
+}
\ No newline at end of file
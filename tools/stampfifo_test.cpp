@@ -0,0 +1,87 @@
+// Boundary checks for queue::StampFifo, the enqueue-time record behind the queue latency histograms:
+//
+//     g++ -std=c++20 -O2 -I tools/host -I main/wrappers tools/stampfifo_test.cpp -o stampfifo_test && ./stampfifo_test
+//
+// Drives the FIFO with a fake clock through every fill level up to and past Depth, across index wrap-around, and checks each pop either
+// reports exactly its item's latency or is skipped; a skipped sample is only allowed once Depth items are queued.
+
+#include "queuestats.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+namespace
+{
+
+    std::int64_t now{0};
+
+    constexpr std::size_t depth{4};
+
+    struct Fifo
+    {
+        queue::StampFifo<depth> stamps{};
+        std::deque<std::int64_t> pushed_at{};
+
+        void push()
+        {
+            pushed_at.push_back(++now); // NOTE: Every push at a distinct time, so a wrong slot shows up as a wrong latency
+            stamps.stamp();
+            stamps.commit();
+        }
+
+        [[nodiscard]] bool pop()
+        {
+            const auto queued = pushed_at.size();
+            const auto expected = now + 100 - pushed_at.front();
+            pushed_at.pop_front();
+
+            now += 100;
+            const auto latency = stamps.latency();
+
+            if (queued >= depth)
+            {
+                if (latency != -1)
+                {
+                    std::printf("FAIL: %zu queued should skip the sample, got %lld\n", queued, static_cast<long long>(latency));
+                    return false;
+                }
+            }
+            else if (latency != expected)
+            {
+                std::printf("FAIL: %zu queued, latency %lld, expected %lld\n", queued, static_cast<long long>(latency),
+                            static_cast<long long>(expected));
+                return false;
+            }
+
+            return true;
+        }
+    };
+
+} // namespace
+
+std::int64_t esp_timer_get_time() { return now; }
+
+int main()
+{
+    Fifo fifo{};
+    std::size_t samples{0};
+
+    for (std::size_t round = 0; round < 1'000; ++round) // NOTE: Enough rounds for the slot index to wrap many times
+    {
+        const auto fill = 1 + round % (depth + 2); // NOTE: 1 .. Depth + 1 queued
+        for (std::size_t i = 0; i < fill; ++i)
+            fifo.push();
+
+        while (not fifo.pushed_at.empty())
+        {
+            if (not fifo.pop())
+                return EXIT_FAILURE;
+            ++samples;
+        }
+    }
+
+    std::printf("OK: %zu pops checked\n", samples);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Host build of timer::Wheel with the same workload as benchmark::timer_wheel on the target:
+//
+//     g++ -std=c++20 -O2 -I main/wrappers tools/timerwheel_bench.cpp -o timerwheel_bench && ./timerwheel_bench
+//
+// For each outstanding count it prints the cost of schedule, cancel+reschedule and a 1 ms tick, plus a naive sorted-list baseline for
+// the schedule cost, which is what one kernel timeout per wait amounts to.
+
+#include "timerwheel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    void noop_callback(timer::Timer &) {}
+
+    [[nodiscard]] std::uint32_t next_delay(std::uint32_t &seed)
+    {
+        seed = seed * 1664525 + 1013904223;
+        return 1 + (seed >> 8) % 60'000;
+    }
+
+    [[nodiscard]] double ns_per(Clock::duration elapsed, std::size_t operations)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / operations;
+    }
+
+    void bench(std::size_t count, std::uint32_t ticks)
+    {
+        std::vector<timer::Timer> timers(count);
+        auto wheel = std::make_unique<timer::Wheel<>>();
+        std::uint32_t seed{1};
+
+        auto start = Clock::now();
+        for (auto &timer : timers)
+        {
+            timer.callback = noop_callback;
+            wheel->schedule_in(timer, next_delay(seed));
+        }
+        const auto schedule = Clock::now() - start;
+
+        start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto &timer = timers[(i * 7919) % count];
+            wheel->cancel(timer);
+            wheel->schedule_in(timer, next_delay(seed));
+        }
+        const auto cancel = Clock::now() - start;
+
+        std::size_t expired{0};
+        timer::List due{};
+
+        start = Clock::now();
+        for (std::uint32_t tick = 1; tick <= ticks; ++tick)
+        {
+            expired += wheel->advance(wheel->now() + 1, due);
+            while (auto timer = due.pop_front())
+            {
+                timer->callback(*timer);
+                wheel->schedule_in(*timer, next_delay(seed));
+            }
+        }
+        const auto advance = Clock::now() - start;
+
+        std::list<std::uint32_t> sorted{}; // NOTE: Ordered insert, as a kernel timer list does
+        seed = 1;
+        start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto deadline = next_delay(seed);
+            auto at = sorted.begin();
+            while (at != sorted.end() and *at <= deadline)
+                ++at;
+            sorted.insert(at, deadline);
+        }
+        const auto baseline = Clock::now() - start;
+
+        std::printf("%6zu timers: schedule %6.1f ns (sorted list %8.1f ns), cancel+reschedule %6.1f ns, %u ticks at %7.1f ns/tick with %zu expiries\n", count,
+                    ns_per(schedule, count), ns_per(baseline, count), ns_per(cancel, count), ticks, ns_per(advance, ticks), expired);
+
+        for (auto &timer : timers)
+            wheel->cancel(timer);
+    }
+
+} // namespace
+
+int main()
+{
+    for (const std::size_t count : {10, 1'000, 10'000})
+        bench(count, 5'000);
+}
\ No newline at end of file